@@ -6,26 +6,154 @@
 #include <stdbool.h>
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
+#include "inc/hw_ints.h"
+#include "inc/tm4c123gh6pm.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "pin_gpio.h"
 
-#define PF12	HWREG(GPIO_PORTF_BASE + 0x8 + 0x10)
+// Reloj del sistema con el PLL a RELOJ_OBJETIVO (80MHz por defecto), define RELOJ_SISTEMA para los retardos
+#include "reloj.h"
+#include "retardo.h"
+
+// Descomentar para medir la velocidad de conmutacion y la latencia de interrupcion en APB y AHB
+//#define __BENCHMARK_GPIO__
+#define BENCH_TOGGLES		1000
+#define BENCH_LATENCIAS		16
+
+DEFINIR_PIN(PF12, GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2)
+
+#ifdef __BENCHMARK_GPIO__
+// Resultados del benchmark, en ciclos del reloj del sistema
+uint32_t ciclosToggleAPB, ciclosToggleAHB;		// por par de escrituras (alto y bajo)
+uint32_t togglesSegAPB, togglesSegAHB;			// frecuencia de conmutacion resultante
+uint32_t latenciaMinAPB, latenciaMaxAPB;		// escritura del pin a la primera instruccion de la ISR
+uint32_t latenciaMinAHB, latenciaMaxAHB;
+
+void GPIO_Benchmark(void);
+#endif
+
+// Estado de la medicion de latencia, tambien lo usa la rutina de interrupcion
+static volatile uint32_t benchPuerto = GPIO_PORTF_BASE;
+static volatile uint32_t benchInicio;
+static volatile uint32_t benchLatencia;
+static volatile bool benchListo;
 
 int main(void) {
-	
-	SysCtlClockSet(SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ | SYSCTL_USE_PLL | SYSCTL_SYSDIV_5);
+	// Configurar el reloj a RELOJ_SISTEMA
+	Reloj_Init();
 
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2);
-	GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2, 0xff);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2);
+	GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2, 0xff);
+
+#ifdef __BENCHMARK_GPIO__
+	GPIO_Benchmark();
+#endif
 
 	while (1) {
-		//GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2, 0x00);
-		PF12 = 0xff;
-		SysCtlDelay(13000000);
-		//GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2, 0xff);
-		PF12 = 0x00;
-		SysCtlDelay(13000000);
+		//GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2, 0x00);
+		PF12_Alto();
+		RETARDO_MS(975);
+		//GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2, 0xff);
+		PF12_Bajo();
+		RETARDO_MS(975);
+	}
+
+}
+
+#ifdef __BENCHMARK_GPIO__
+/*
+ * Ciclos de BENCH_TOGGLES pares de escrituras en PF1 por la direccion "puerto"
+ */
+static uint32_t Bench_Toggle(uint32_t puerto) {
+	volatile uint32_t *dato = (volatile uint32_t *)(puerto + GPIO_O_DATA + (GPIO_PIN_1 << 2));
+	uint32_t i, inicio;
+
+	inicio = NVIC_ST_CURRENT_R;
+	for (i = 0; i < BENCH_TOGGLES; i++) {
+		*dato = 0xff;
+		*dato = 0;
+	}
+	return ((inicio - NVIC_ST_CURRENT_R) & 0x00ffffff) / BENCH_TOGGLES;
+}
+
+/*
+ * Latencia desde la escritura de PF1 hasta la rutina de interrupcion de su flanco de subida.
+ * La interrupcion del GPIO tambien se genera con el pin como salida.
+ */
+static void Bench_Latencia(uint32_t puerto, uint32_t *minimo, uint32_t *maximo) {
+	volatile uint32_t *dato = (volatile uint32_t *)(puerto + GPIO_O_DATA + (GPIO_PIN_1 << 2));
+	uint32_t i;
+
+	benchPuerto = puerto;
+	*dato = 0;
+	GPIOIntTypeSet(puerto, GPIO_PIN_1, GPIO_RISING_EDGE);
+	GPIOIntClear(puerto, GPIO_INT_PIN_1);
+	GPIOIntEnable(puerto, GPIO_INT_PIN_1);
+
+	*minimo = 0xffffffff;
+	*maximo = 0;
+	for (i = 0; i < BENCH_LATENCIAS; i++) {
+		benchListo = false;
+		benchInicio = NVIC_ST_CURRENT_R;
+		*dato = 0xff;
+		while (!benchListo) {}
+		if (benchLatencia < *minimo) *minimo = benchLatencia;
+		if (benchLatencia > *maximo) *maximo = benchLatencia;
+		*dato = 0;
 	}
 
+	GPIOIntDisable(puerto, GPIO_INT_PIN_1);
+}
+
+/*
+ * Compara los accesos por APB y AHB al puerto F y deja el bus configurado por __GPIO_AHB__.
+ * Usa SysTick con el reloj del sistema como contador de ciclos (24 bits, ~419ms@40MHz).
+ */
+void GPIO_Benchmark(void) {
+	uint32_t reloj = Reloj_Frecuencia();
+
+	// SysTick libre, sin interrupciones
+	NVIC_ST_CTRL_R = 0;
+	NVIC_ST_RELOAD_R = 0x00ffffff;
+	NVIC_ST_CURRENT_R = 0;
+	NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE | NVIC_ST_CTRL_CLK_SRC;
+
+	IntEnable(INT_GPIOF);
+	IntMasterEnable();
+
+	// Bus APB
+	SysCtlGPIOAHBDisable(SYSCTL_PERIPH_GPIOF);
+	ciclosToggleAPB = Bench_Toggle(GPIO_PORTF_BASE);
+	Bench_Latencia(GPIO_PORTF_BASE, &latenciaMinAPB, &latenciaMaxAPB);
+
+	// Bus AHB, la configuracion del puerto se conserva al cambiar de apertura
+	SysCtlGPIOAHBEnable(SYSCTL_PERIPH_GPIOF);
+	ciclosToggleAHB = Bench_Toggle(GPIO_PORTF_AHB_BASE);
+	Bench_Latencia(GPIO_PORTF_AHB_BASE, &latenciaMinAHB, &latenciaMaxAHB);
+
+#ifdef __GPIO_AHB__
+	benchPuerto = GPIO_PORTF_AHB_BASE;
+#else
+	SysCtlGPIOAHBDisable(SYSCTL_PERIPH_GPIOF);
+	benchPuerto = GPIO_PORTF_BASE;
+#endif
+	IntDisable(INT_GPIOF);
+	NVIC_ST_CTRL_R = 0;
+
+	togglesSegAPB = reloj / ciclosToggleAPB;
+	togglesSegAHB = reloj / ciclosToggleAHB;
+}
+#endif
+
+/*
+ * Rutina de interrupcion del puerto F, solo se habilita durante el benchmark
+ */
+void Int_GPIOF_Handler(void) {
+	benchLatencia = (benchInicio - NVIC_ST_CURRENT_R) & 0x00ffffff;
+	GPIOIntClear(benchPuerto, GPIO_INT_PIN_1);
+	benchListo = true;
 }
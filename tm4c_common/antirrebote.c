@@ -0,0 +1,77 @@
+/*
+ * antirrebote.c
+ *
+ * Filtro antirrebote por registro de desplazamiento, ver antirrebote.h
+ */
+
+#include "antirrebote.h"
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+
+// Lectura de los pines por medio de la mascara de direcciones del registro DATA
+#define LEER_PINES(a)	((uint8_t)HWREG((a)->puerto + GPIO_O_DATA + ((uint32_t)(a)->pines << 2)))
+
+/*
+ * Inicializa el filtro con el estado actual de los pines, sin generar eventos
+ */
+void Antirrebote_Init(t_antirrebote *a, uint32_t puerto, uint8_t pines) {
+	uint8_t i, lectura;
+
+	a->puerto = puerto;
+	a->pines = pines;
+	lectura = LEER_PINES(a);
+	for (i = 0; i < ANTIRREBOTE_MUESTRAS; i++) {
+		a->muestras[i] = lectura;
+	}
+	a->indice = 0;
+	a->estado = lectura;
+	a->presionados = 0;
+	a->liberados = 0;
+}
+
+/*
+ * Toma una muestra de los pines y actualiza el estado filtrado. Llamar desde la interrupcion periodica.
+ * Devuelve true si todos los pines estan estables (las ultimas muestras coinciden con el estado).
+ */
+bool Antirrebote_Muestrear(t_antirrebote *a) {
+	uint8_t i, altos, bajos, nuevo, cambios;
+
+	a->muestras[a->indice] = LEER_PINES(a);
+	a->indice = (a->indice + 1) % ANTIRREBOTE_MUESTRAS;
+
+	// Pines en alto en todas las muestras y pines en bajo en todas las muestras
+	altos = a->pines;
+	bajos = a->pines;
+	for (i = 0; i < ANTIRREBOTE_MUESTRAS; i++) {
+		altos &= a->muestras[i];
+		bajos &= ~a->muestras[i];
+	}
+
+	// Los pines que no son estables conservan su estado anterior
+	nuevo = (a->estado | altos) & ~bajos;
+	cambios = nuevo ^ a->estado;
+	a->presionados |= cambios & ~nuevo;
+	a->liberados |= cambios & nuevo;
+	a->estado = nuevo;
+
+	return (altos | bajos) == a->pines;
+}
+
+/*
+ * Devuelve y borra los eventos de presion pendientes (mascara de pines).
+ * Llamar desde el mismo contexto que Antirrebote_Muestrear o con las interrupciones deshabilitadas.
+ */
+uint8_t Antirrebote_Presionados(t_antirrebote *a) {
+	uint8_t eventos = a->presionados;
+	a->presionados = 0;
+	return eventos;
+}
+
+/*
+ * Devuelve y borra los eventos de liberacion pendientes (mascara de pines)
+ */
+uint8_t Antirrebote_Liberados(t_antirrebote *a) {
+	uint8_t eventos = a->liberados;
+	a->liberados = 0;
+	return eventos;
+}
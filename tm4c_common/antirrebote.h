@@ -0,0 +1,37 @@
+/*
+ * antirrebote.h
+ *
+ * Filtro antirrebote para los botones de un puerto. Se llama a Antirrebote_Muestrear desde una
+ * interrupcion periodica; un pin cambia de estado cuando sus ultimas ANTIRREBOTE_MUESTRAS lecturas
+ * coinciden, por lo que el tiempo de antirrebote es ANTIRREBOTE_MUESTRAS * periodo de muestreo.
+ * Todos los pines se filtran en paralelo y no hay esperas dentro de las interrupciones.
+ *
+ * Los botones de la Launchpad tienen pull-up: presionado = 0.
+ */
+
+#ifndef ANTIRREBOTE_H_
+#define ANTIRREBOTE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ANTIRREBOTE_MUESTRAS	4
+
+struct antirrebote {
+	uint32_t puerto;							// direccion base del puerto GPIO
+	uint8_t pines;								// mascara de pines filtrados
+	uint8_t muestras[ANTIRREBOTE_MUESTRAS];		// ultimas lecturas del puerto
+	uint8_t indice;
+	uint8_t estado;								// estado filtrado de los pines
+	uint8_t presionados;						// eventos pendientes de 1 a 0
+	uint8_t liberados;							// eventos pendientes de 0 a 1
+};
+
+typedef struct antirrebote t_antirrebote;
+
+void Antirrebote_Init(t_antirrebote *a, uint32_t puerto, uint8_t pines);
+bool Antirrebote_Muestrear(t_antirrebote *a);
+uint8_t Antirrebote_Presionados(t_antirrebote *a);
+uint8_t Antirrebote_Liberados(t_antirrebote *a);
+
+#endif /* ANTIRREBOTE_H_ */
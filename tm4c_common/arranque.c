@@ -0,0 +1,59 @@
+/*
+ * arranque.c
+ *
+ * Marcas de tiempo del arranque, ver arranque.h
+ */
+
+#include "arranque.h"
+#include "perfil.h"
+#include "reloj.h"
+
+#ifdef __TI_COMPILER_VERSION__
+#pragma NOINIT(arranque)
+t_arranque arranque;
+#else
+t_arranque arranque __attribute__((section(".noinit")));
+#endif
+
+/*
+ * Primera instruccion de ResetISR: habilita el CYCCNT desde 0 e inicia las marcas.
+ * Corre antes de _c_int00, solo usa la pila.
+ */
+void Arranque_Reset(void) {
+	uint32_t i;
+
+	*((volatile uint32_t *)DEMCR) |= 0x01000000;
+	*((volatile uint32_t *)DWT_CYCCNT) = 0;
+	*((volatile uint32_t *)DWT_CTRL) |= 0x00000001;
+
+	for (i = 0; i < ARRANQUE_FASES; i++) {
+		arranque.ciclos[i] = 0;
+		arranque.us[i] = 0;
+	}
+	arranque.reloj = RELOJ_CRISTAL;		// PIOSC despues del reset
+	arranque.ultima = ARRANQUE_RESET;
+}
+
+/*
+ * Guarda los ciclos de la fase y su tiempo desde el reset. Las fases pueden marcarse en
+ * cualquier orden (en el arranque rapido la primera muestra va antes del reloj), el tiempo se
+ * acumula desde la ultima marca.
+ */
+void Arranque_Marcar(t_faseArranque fase) {
+	uint32_t ahora = PERFIL_CICLOS();
+
+	arranque.ciclos[fase] = ahora;
+	arranque.us[fase] = arranque.us[arranque.ultima] +
+			(ahora - arranque.ciclos[arranque.ultima]) / (arranque.reloj / 1000000);
+	arranque.reloj = Reloj_Frecuencia();
+	arranque.ultima = fase;
+}
+
+/*
+ * Gancho de la libreria de TI, _c_int00 lo llama antes de copiar .cinit; 1 para hacer la copia
+ */
+int _system_pre_init(void) {
+	Arranque_Marcar(ARRANQUE_PREINIT);
+	arranque.reloj = RELOJ_CRISTAL;		// relojes todavia no esta inicializado
+	return 1;
+}
@@ -0,0 +1,53 @@
+/*
+ * arranque.h
+ *
+ * Marcas de tiempo de las fases del arranque con el contador de ciclos del DWT (CYCCNT), desde
+ * ResetISR hasta la primera muestra:
+ *  - ARRANQUE_RESET: ResetISR llama Arranque_Reset antes de saltar a _c_int00 (contador en 0)
+ *  - ARRANQUE_PREINIT: _system_pre_init, antes de copiar .cinit y borrar .bss
+ *  - ARRANQUE_MAIN: entrada a main, despues de .cinit
+ *  - ARRANQUE_RELOJ: reloj del sistema configurado
+ *  - ARRANQUE_PERIFERICOS: perifericos configurados
+ *  - ARRANQUE_PRIMERA: primera muestra del ADC o primer byte por UART
+ *
+ * Cada fase guarda los ciclos y el tiempo en us desde el reset, con el reloj que habia al marcar
+ * la fase anterior (16MHz hasta Reloj_Init). Las marcas quedan en arranque para el debugger.
+ * arranque esta fuera de .bss (NOINIT) para que _c_int00 no borre las marcas anteriores a main;
+ * el archivo de enlace debe ubicar .TI.noinit en SRAM.
+ *
+ * Arranque_Reset habilita el CYCCNT; perfil.c ya no lo reinicia en Perfil_Init.
+ */
+
+#ifndef ARRANQUE_H_
+#define ARRANQUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum faseArranque {
+	ARRANQUE_RESET,
+	ARRANQUE_PREINIT,
+	ARRANQUE_MAIN,
+	ARRANQUE_RELOJ,
+	ARRANQUE_PERIFERICOS,
+	ARRANQUE_PRIMERA,
+	ARRANQUE_FASES
+};
+
+typedef enum faseArranque t_faseArranque;
+
+struct arranque {
+	uint32_t ciclos[ARRANQUE_FASES];	// CYCCNT al marcar cada fase, 0 si no se marco
+	uint32_t us[ARRANQUE_FASES];		// tiempo desde el reset en us
+	uint32_t reloj;						// reloj del sistema en la ultima marca
+	uint32_t ultima;					// ultima fase marcada
+};
+
+typedef struct arranque t_arranque;
+
+extern t_arranque arranque;
+
+void Arranque_Reset(void);
+void Arranque_Marcar(t_faseArranque fase);
+
+#endif /* ARRANQUE_H_ */
@@ -0,0 +1,27 @@
+/*
+ * codigo_ram.c
+ *
+ * Copia de .ramfunc a SRAM, ver codigo_ram.h
+ */
+
+#include "codigo_ram.h"
+
+// Simbolos del archivo de enlace, su direccion es el valor
+extern uint8_t codigoRAMCarga, codigoRAMInicio, codigoRAMTamano;
+
+void CodigoRAM_Init(void) {
+	const uint8_t *carga = &codigoRAMCarga;
+	uint8_t *destino = &codigoRAMInicio;
+	uint32_t i, tamano = (uint32_t)&codigoRAMTamano;
+
+	for (i = 0; i < tamano; i++) {
+		destino[i] = carga[i];
+	}
+}
+
+/*
+ * Direccion en flash de la funcion EN_RAM, conserva el bit de Thumb
+ */
+uint32_t CodigoRAM_Flash(uint32_t funcion) {
+	return funcion - (uint32_t)&codigoRAMInicio + (uint32_t)&codigoRAMCarga;
+}
@@ -0,0 +1,31 @@
+/*
+ * codigo_ram.h
+ *
+ * Funciones que corren desde SRAM, sin los estados de espera de la flash arriba de 40MHz.
+ * EN_RAM pone la funcion en la seccion .ramfunc, que el archivo de enlace carga en flash y
+ * ubica en SRAM:
+ *
+ *     .ramfunc : LOAD = FLASH, RUN = SRAM, LOAD_START(codigoRAMCarga),
+ *                RUN_START(codigoRAMInicio), SIZE(codigoRAMTamano)
+ *
+ * CodigoRAM_Init copia la seccion al inicio de main, antes de habilitar las interrupciones
+ * cuyos manejadores esten en SRAM. Las llamadas de SRAM a flash (y al reves) las resuelve el
+ * enlazador con trampolines.
+ *
+ * CodigoRAM_Flash da la direccion de la copia de carga en flash de una funcion EN_RAM para
+ * comparar ciclos con la misma funcion. Solo sirve para funciones hoja (sin llamadas, que son
+ * relativas al PC): los accesos a datos van por la tabla de literales y no dependen de donde
+ * corre el codigo.
+ */
+
+#ifndef CODIGO_RAM_H_
+#define CODIGO_RAM_H_
+
+#include <stdint.h>
+
+#define EN_RAM		__attribute__((section(".ramfunc"), noinline))
+
+void CodigoRAM_Init(void);
+uint32_t CodigoRAM_Flash(uint32_t funcion);
+
+#endif /* CODIGO_RAM_H_ */
@@ -0,0 +1,49 @@
+/*
+ * divisor.h
+ *
+ * Divisores de baud rate de UART calculados sin SysCtlClockGet. Con el reloj fijo
+ * (RELOJ_SISTEMA de reloj.h) UART_DIVISOR es una constante y Divisor_UART solo escribe los
+ * registros; con reloj variable se usa relojes.sistema del arbol de relojes.
+ *
+ * Con ClkDiv = 16: IBRD + FBRD/64 = reloj / (16 * baud), FBRD redondeado
+ */
+
+#ifndef DIVISOR_H_
+#define DIVISOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+
+// Divisor en 1/64, reloj * 64 / (16 * baud) redondeado, hasta 536MHz sin desbordar
+#define UART_DIVISOR(reloj, baud)	((((uint32_t)(reloj) * 8u) / (baud) + 1) >> 1)
+#define UART_IBRD(divisor)			((divisor) >> 6)
+#define UART_FBRD(divisor)			((divisor) & 0x3f)
+
+// IBRD de 16 bits y distinto de 0, usar en un typedef de arreglo para revisarlo al compilar
+#define UART_DIVISOR_VALIDO(reloj, baud)	\
+	((UART_IBRD(UART_DIVISOR(reloj, baud)) >= 1 && UART_IBRD(UART_DIVISOR(reloj, baud)) <= 0xffff) ? 1 : -1)
+
+/*
+ * Lo mismo que UARTConfigSetExpClk con el divisor ya calculado. config son los bits de
+ * UARTLCRH (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE...)
+ */
+static inline void Divisor_UART(uint32_t base, uint32_t divisor, uint32_t config) {
+	// Esperar a que termine el caracter actual y deshabilitar
+	while (HWREG(base + UART_O_FR) & UART_FR_BUSY) {}
+	HWREG(base + UART_O_LCRH) &= ~UART_LCRH_FEN;
+	HWREG(base + UART_O_CTL) &= ~(UART_CTL_UARTEN | UART_CTL_TXE | UART_CTL_RXE);
+
+	HWREG(base + UART_O_IBRD) = UART_IBRD(divisor);
+	HWREG(base + UART_O_FBRD) = UART_FBRD(divisor);
+	// LCRH despues de IBRD/FBRD para que se carguen los divisores
+	HWREG(base + UART_O_LCRH) = config;
+	HWREG(base + UART_O_FR) = 0;
+
+	// Habilitar con FIFOs, como UARTEnable
+	HWREG(base + UART_O_LCRH) |= UART_LCRH_FEN;
+	HWREG(base + UART_O_CTL) |= UART_CTL_UARTEN | UART_CTL_TXE | UART_CTL_RXE;
+}
+
+#endif /* DIVISOR_H_ */
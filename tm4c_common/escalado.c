@@ -0,0 +1,61 @@
+/*
+ * escalado.c
+ *
+ * Escalado dinamico de frecuencia, ver escalado.h
+ */
+
+#include "escalado.h"
+#include "reloj.h"
+#include "driverlib/interrupt.h"
+
+static t_avisoReloj *avisos = 0;
+static t_perfilReloj perfilActual = RELOJ_RAFAGA;		// despues de Reloj_Init
+
+/*
+ * Registra funcion para que se llame en cada cambio de reloj. El aviso lo reserva quien lo usa.
+ */
+void Escalado_Avisar(t_avisoReloj *a, t_funcionAviso funcion) {
+	bool deshabilitadas = IntMasterDisable();
+
+	a->funcion = funcion;
+	a->sig = avisos;
+	avisos = a;
+
+	if (!deshabilitadas) {
+		IntMasterEnable();
+	}
+}
+
+/*
+ * Cambia al perfil y reconfigura los perifericos registrados. Devuelve false si el PLL no cerro
+ * (se queda en el perfil lento, los avisos ya vieron el reloj real).
+ */
+bool Escalado_Cambiar(t_perfilReloj perfil) {
+	bool deshabilitadas = IntMasterDisable(), listo = true;
+	uint32_t anterior = Reloj_Frecuencia();
+	t_avisoReloj *a;
+
+	if (perfil != perfilActual) {
+		if (perfil == RELOJ_RAFAGA) {
+			listo = Reloj_PLL();
+		} else {
+			Reloj_Oscilador();
+		}
+		perfilActual = listo ? perfil : RELOJ_LENTO;
+
+		if (Reloj_Frecuencia() != anterior) {
+			for (a = avisos; a != 0; a = a->sig) {
+				a->funcion(anterior, Reloj_Frecuencia());
+			}
+		}
+	}
+
+	if (!deshabilitadas) {
+		IntMasterEnable();
+	}
+	return listo;
+}
+
+t_perfilReloj Escalado_Perfil(void) {
+	return perfilActual;
+}
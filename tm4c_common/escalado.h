@@ -0,0 +1,43 @@
+/*
+ * escalado.h
+ *
+ * Escalado dinamico de frecuencia entre dos perfiles de reloj:
+ *  - RELOJ_LENTO: oscilador de 16MHz sin dividir y PLL apagado, para cuando solo hay muestreo lento
+ *  - RELOJ_RAFAGA: PLL a RELOJ_SISTEMA (reloj.h, 80MHz por defecto) para procesar bloques
+ *
+ * Cada modulo que depende del reloj (divisores de UART, cargas de timers, prescaler de SSI, base de
+ * tiempo) registra un aviso que se llama despues de cada cambio con el reloj anterior y el nuevo.
+ * Los avisos corren con las interrupciones deshabilitadas, asi ninguna interrupcion ve un periferico
+ * a medio reconfigurar. Los perifericos que usan el reloj del ADC (PLL / 25) deben pasar al PIOSC
+ * porque el PLL se apaga en el perfil lento.
+ *
+ * Con reloj dinamico el proyecto define RELOJ_DINAMICO para que retardo.h use la base de tiempo.
+ */
+
+#ifndef ESCALADO_H_
+#define ESCALADO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum perfilReloj {
+	RELOJ_LENTO,
+	RELOJ_RAFAGA
+};
+
+typedef enum perfilReloj t_perfilReloj;
+
+typedef void (*t_funcionAviso)(uint32_t relojAnterior, uint32_t relojNuevo);
+
+struct avisoReloj {
+	struct avisoReloj *sig;
+	t_funcionAviso funcion;
+};
+
+typedef struct avisoReloj t_avisoReloj;
+
+void Escalado_Avisar(t_avisoReloj *a, t_funcionAviso funcion);
+bool Escalado_Cambiar(t_perfilReloj perfil);
+t_perfilReloj Escalado_Perfil(void);
+
+#endif /* ESCALADO_H_ */
@@ -0,0 +1,140 @@
+/*
+ * perfil.c
+ *
+ * Sondas de perfilado con el DWT CYCCNT, ver perfil.h
+ */
+
+#include "perfil.h"
+
+#ifdef PERFIL_HOST
+volatile uint32_t perfilCiclosHost = 0;
+#define SECCION_INICIO()
+#define SECCION_FIN()
+#else
+#include "driverlib/interrupt.h"
+#define SECCION_INICIO()	bool deshabilitadas = IntMasterDisable()
+#define SECCION_FIN()		if (!deshabilitadas) { IntMasterEnable(); }
+#endif
+
+static t_sonda *sondas = 0;			// lista de sondas que ya midieron
+static uint32_t ajuste = 0;			// ciclos de una medicion vacia
+
+static t_sonda calibracion;
+
+/*
+ * Habilita el CYCCNT y mide el costo de PERFIL_INICIO/PERFIL_FIN sin nada en medio
+ */
+void Perfil_Init(void) {
+	uint32_t i, ciclos;
+
+#ifndef PERFIL_HOST
+	// Sin reiniciar el CYCCNT, arranque.c lo usa desde el reset
+	*((volatile uint32_t *)DEMCR) |= 0x01000000;
+	*((volatile uint32_t *)DWT_CTRL) |= 0x00000001;
+#endif
+
+	ajuste = 0xffffffff;
+	for (i = 0; i < 8; i++) {
+		calibracion.inicio = PERFIL_CICLOS();
+		ciclos = PERFIL_CICLOS() - calibracion.inicio;
+		if (ciclos < ajuste) {
+			ajuste = ciclos;
+		}
+	}
+}
+
+/*
+ * Suma una medicion a la sonda, la primera vez la agrega a la lista del volcado
+ */
+void Perfil_Acumular(t_sonda *s, uint32_t ciclos) {
+	ciclos = (ciclos > ajuste) ? ciclos - ajuste : 0;
+
+	if (s->sig == 0) {
+		SECCION_INICIO();
+		if (s->sig == 0) {
+			// El ultimo elemento apunta a si mismo para distinguirlo de una sonda sin enlazar
+			s->sig = (sondas != 0) ? sondas : s;
+			sondas = s;
+		}
+		SECCION_FIN();
+	}
+
+	s->n++;
+	s->suma += ciclos;
+	if (ciclos < s->min) {
+		s->min = ciclos;
+	}
+	if (ciclos > s->max) {
+		s->max = ciclos;
+	}
+}
+
+static t_sonda *Perfil_Siguiente(t_sonda *s) {
+	return (s->sig == s) ? 0 : s->sig;
+}
+
+/*
+ * Borra las mediciones de todas las sondas
+ */
+void Perfil_Reiniciar(void) {
+	t_sonda *s;
+
+	for (s = sondas; s != 0; s = Perfil_Siguiente(s)) {
+		SECCION_INICIO();
+		s->n = 0;
+		s->suma = 0;
+		s->min = 0xffffffff;
+		s->max = 0;
+		SECCION_FIN();
+	}
+}
+
+static void Perfil_Texto(void (*enviar)(uint8_t), const char *texto, uint32_t ancho) {
+	while (*texto != 0) {
+		enviar((uint8_t)*texto++);
+		if (ancho > 0) {
+			ancho--;
+		}
+	}
+	while (ancho-- > 0) {
+		enviar(' ');
+	}
+}
+
+static void Perfil_Numero(void (*enviar)(uint8_t), uint32_t num, uint32_t ancho) {
+	char digitos[11];
+	uint32_t i = sizeof(digitos) - 1;
+
+	digitos[i] = 0;
+	do {
+		digitos[--i] = '0' + (num % 10);
+		num /= 10;
+	} while (num != 0);
+	while ((sizeof(digitos) - 1 - i) < ancho && i > 0) {
+		digitos[--i] = ' ';
+	}
+	Perfil_Texto(enviar, &digitos[i], 0);
+}
+
+/*
+ * Envia una linea de texto por sonda: nombre, mediciones y ciclos minimo, maximo y promedio
+ */
+void Perfil_Volcar(void (*enviar)(uint8_t dato)) {
+	t_sonda *s;
+	t_sonda copia;
+
+	Perfil_Texto(enviar, "sonda", 16);
+	Perfil_Texto(enviar, "         n       min       max     media\r\n", 0);
+	for (s = sondas; s != 0; s = Perfil_Siguiente(s)) {
+		SECCION_INICIO();
+		copia = *s;
+		SECCION_FIN();
+
+		Perfil_Texto(enviar, copia.nombre, 16);
+		Perfil_Numero(enviar, copia.n, 10);
+		Perfil_Numero(enviar, (copia.n != 0) ? copia.min : 0, 10);
+		Perfil_Numero(enviar, copia.max, 10);
+		Perfil_Numero(enviar, (copia.n != 0) ? (uint32_t)(copia.suma / copia.n) : 0, 10);
+		Perfil_Texto(enviar, "\r\n", 0);
+	}
+}
@@ -0,0 +1,60 @@
+/*
+ * perfil.h
+ *
+ * Sondas de perfilado con el contador de ciclos del DWT (CYCCNT): cada sonda guarda el numero de
+ * mediciones y el minimo, maximo y suma de ciclos entre PERFIL_INICIO y PERFIL_FIN, ya sin el costo
+ * de la propia medicion. Las sondas se agregan a la lista del volcado la primera vez que miden.
+ *
+ * Las macros solo generan codigo si el archivo que las usa define __PERFIL__ antes de incluir
+ * este encabezado, asi que se pueden dejar en las rutinas de interrupcion. Una sonda no es
+ * reentrante: cada contexto (rutina de interrupcion o programa principal) usa las suyas.
+ * El CYCCNT no cuenta mientras el nucleo duerme (WFI).
+ *
+ * Con PERFIL_HOST (programas de tm4c_hostSim) el contador es perfilCiclosHost, que el simulador
+ * avanza con su propia cuenta de ciclos.
+ */
+
+#ifndef PERFIL_H_
+#define PERFIL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PERFIL_HOST
+extern volatile uint32_t perfilCiclosHost;
+#define PERFIL_CICLOS()		(perfilCiclosHost)
+#else
+#define DWT_CTRL			0xE0001000		// control del DWT, bit 0 CYCCNTENA
+#define DWT_CYCCNT			0xE0001004		// contador de ciclos
+#define DEMCR				0xE000EDFC		// debug exception and monitor control, bit 24 TRCENA
+#define PERFIL_CICLOS()		(*((volatile uint32_t *)DWT_CYCCNT))
+#endif
+
+struct sonda {
+	const char *nombre;
+	struct sonda *sig;			// lista de sondas para el volcado
+	uint32_t inicio;
+	uint32_t n;
+	uint32_t min;
+	uint32_t max;
+	uint64_t suma;
+};
+
+typedef struct sonda t_sonda;
+
+#ifdef __PERFIL__
+#define PERFIL_SONDA(s)		t_sonda s = {#s, 0, 0, 0, 0xffffffff, 0, 0}
+#define PERFIL_INICIO(s)	((s).inicio = PERFIL_CICLOS())
+#define PERFIL_FIN(s)		Perfil_Acumular(&(s), PERFIL_CICLOS() - (s).inicio)
+#else
+#define PERFIL_SONDA(s)		extern t_sonda s
+#define PERFIL_INICIO(s)
+#define PERFIL_FIN(s)
+#endif
+
+void Perfil_Init(void);
+void Perfil_Acumular(t_sonda *s, uint32_t ciclos);
+void Perfil_Reiniciar(void);
+void Perfil_Volcar(void (*enviar)(uint8_t dato));
+
+#endif /* PERFIL_H_ */
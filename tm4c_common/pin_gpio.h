@@ -0,0 +1,110 @@
+/*
+ * pin_gpio.h
+ *
+ * Pines GPIO tipados sobre la mascara de direcciones del registro DATA. Cada pin (o grupo de pines
+ * del mismo puerto) se declara con DEFINIR_PIN y genera funciones inline con el puerto y la mascara
+ * constantes, por lo que cada acceso es el mismo load/store que un macro HWREG escrito a mano:
+ *
+ *   DEFINIR_PIN(LED_ROJO, GPIO_PUERTO_F, GPIO_PIN_1)
+ *   LED_ROJO_Alto();  LED_ROJO_Conmutar();  if (LED_ROJO_Leer()) ...
+ *
+ * El puerto debe estar configurado (reloj, direccion, DEN) antes de usar el pin.
+ *
+ * Con __GPIO_AHB__ los puertos se acceden por la apertura del bus AHB (un ciclo por acceso) en lugar
+ * del bus APB. Un puerto con AHB habilitado ya no responde en su direccion APB, por lo que todo el
+ * codigo que usa el puerto debe usar GPIO_PUERTO_x (libreria, DEFINIR_PIN) o GPIO_REG (registros),
+ * y llamar a GPIO_BUS_INIT despues de habilitar su reloj.
+ *
+ * Con GPIO_HOST (programas de tm4c_hostSim) los registros son el arreglo gpioHostBloque del programa,
+ * con las mismas direcciones que el mapa de memoria, y cada HWREG suma uno a gpioHostAccesos.
+ */
+
+#ifndef PIN_GPIO_H_
+#define PIN_GPIO_H_
+
+#include <stdint.h>
+
+#ifdef GPIO_HOST
+// Bloque desde GPIO_HOST_BASE hasta el final de los puertos AHB
+#define GPIO_HOST_BASE		0x40000000
+#define GPIO_HOST_PALABRAS	(0x60000 >> 2)
+extern volatile uint32_t gpioHostBloque[GPIO_HOST_PALABRAS];
+extern uint32_t gpioHostAccesos;
+#define HWREG(x)	(*(gpioHostAccesos++, &gpioHostBloque[((uint32_t)(x) - GPIO_HOST_BASE) >> 2]))
+
+#define GPIO_PORTA_BASE		0x40004000
+#define GPIO_PORTB_BASE		0x40005000
+#define GPIO_PORTC_BASE		0x40006000
+#define GPIO_PORTD_BASE		0x40007000
+#define GPIO_PORTE_BASE		0x40024000
+#define GPIO_PORTF_BASE		0x40025000
+#define GPIO_PORTA_AHB_BASE	0x40058000
+#define GPIO_PORTB_AHB_BASE	0x40059000
+#define GPIO_PORTC_AHB_BASE	0x4005A000
+#define GPIO_PORTD_AHB_BASE	0x4005B000
+#define GPIO_PORTE_AHB_BASE	0x4005C000
+#define GPIO_PORTF_AHB_BASE	0x4005D000
+#define GPIO_O_DATA			0x000
+#define GPIO_O_DIR			0x400
+#define GPIO_O_DEN			0x51C
+#define GPIO_PIN_0			0x01
+#define GPIO_PIN_1			0x02
+#define GPIO_PIN_2			0x04
+#define GPIO_PIN_3			0x08
+#define GPIO_PIN_4			0x10
+#define GPIO_PIN_5			0x20
+#define GPIO_PIN_6			0x40
+#define GPIO_PIN_7			0x80
+#define SysCtlGPIOAHBEnable(periferico)
+#else
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#endif
+
+// Descomentar (o definir en las opciones del compilador del proyecto) para usar el bus AHB
+//#define __GPIO_AHB__
+
+#ifdef __GPIO_AHB__
+#define GPIO_PUERTO_A	GPIO_PORTA_AHB_BASE
+#define GPIO_PUERTO_B	GPIO_PORTB_AHB_BASE
+#define GPIO_PUERTO_C	GPIO_PORTC_AHB_BASE
+#define GPIO_PUERTO_D	GPIO_PORTD_AHB_BASE
+#define GPIO_PUERTO_E	GPIO_PORTE_AHB_BASE
+#define GPIO_PUERTO_F	GPIO_PORTF_AHB_BASE
+#define GPIO_BUS_INIT(periferico)	SysCtlGPIOAHBEnable(periferico)
+#else
+#define GPIO_PUERTO_A	GPIO_PORTA_BASE
+#define GPIO_PUERTO_B	GPIO_PORTB_BASE
+#define GPIO_PUERTO_C	GPIO_PORTC_BASE
+#define GPIO_PUERTO_D	GPIO_PORTD_BASE
+#define GPIO_PUERTO_E	GPIO_PORTE_BASE
+#define GPIO_PUERTO_F	GPIO_PORTF_BASE
+#define GPIO_BUS_INIT(periferico)
+#endif
+
+// Registro de configuracion de un puerto por su desplazamiento (GPIO_O_DIR, GPIO_O_DEN, ...)
+#define GPIO_REG(puerto, registro)	HWREG((puerto) + (registro))
+
+// Registro DATA visto a traves de la mascara: solo se leen o escriben los pines de la mascara
+#define APERTURA_GPIO(puerto, pines)	HWREG((puerto) + GPIO_O_DATA + ((uint32_t)(pines) << 2))
+
+/*
+ * Declara el pin "nombre" con las funciones:
+ *   nombre_Escribir(valor)	escribe valor en los pines (los bits fuera de la mascara no importan)
+ *   nombre_Leer()			lee los pines, los demas bits se leen en 0
+ *   nombre_Alto()			pone los pines en 1
+ *   nombre_Bajo()			pone los pines en 0
+ *   nombre_Conmutar()		invierte los pines (lectura-modificacion-escritura)
+ * La mascara se verifica en tiempo de compilacion (el arreglo tiene tamano negativo si es invalida).
+ */
+#define DEFINIR_PIN(nombre, puerto, pines) \
+	typedef char nombre##_mascaraValida[((pines) > 0 && (pines) <= 0xff) ? 1 : -1]; \
+	static inline void nombre##_Escribir(uint32_t valor) { APERTURA_GPIO(puerto, pines) = valor; } \
+	static inline uint32_t nombre##_Leer(void) { return APERTURA_GPIO(puerto, pines); } \
+	static inline void nombre##_Alto(void) { APERTURA_GPIO(puerto, pines) = 0xff; } \
+	static inline void nombre##_Bajo(void) { APERTURA_GPIO(puerto, pines) = 0; } \
+	static inline void nombre##_Conmutar(void) { APERTURA_GPIO(puerto, pines) ^= 0xff; }
+
+#endif /* PIN_GPIO_H_ */
@@ -0,0 +1,153 @@
+/*
+ * reloj.c
+ *
+ * Configuracion del PLL con RCC2, ver reloj.h
+ */
+
+#include "reloj.h"
+#ifdef PART_LM4F120H5QR
+#include "inc/lm4f120h5qr.h"		// StellarisWare (tm4c_confPLL_test), mismo silicio y registros
+#else
+#include "inc/tm4c123gh6pm.h"
+#endif
+
+t_arbolReloj relojes = {RELOJ_CRISTAL, RELOJ_CRISTAL, RELOJ_CRISTAL, false};	// el reset arranca con el PIOSC
+
+/*
+ * Actualiza el arbol con el nuevo SysClk, el PWM sigue con su divisor
+ */
+static void Reloj_Arbol(uint32_t sistema, bool pll) {
+	uint32_t pwmdiv = (SYSCTL_RCC_R & SYSCTL_RCC_PWMDIV_M) >> SYSCTL_RCC_PWMDIV_S;
+
+	relojes.sistema = sistema;
+	relojes.pll = pll;
+	// PWMDIV: /2, /4, ... /64 (5 a 7)
+	relojes.pwm = (SYSCTL_RCC_R & SYSCTL_RCC_USEPWMDIV) ? sistema >> (pwmdiv < 5 ? pwmdiv + 1 : 6) : sistema;
+}
+
+/*
+ * Espera a que se active el bit de SYSCTL_RIS, false si se acaba la espera
+ */
+static bool Reloj_Esperar(uint32_t bit) {
+	uint32_t espera;
+
+	for (espera = RELOJ_ESPERA; espera > 0; espera--) {
+		if (SYSCTL_RIS_R & bit) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Configura el reloj del sistema a RELOJ_SISTEMA con el cristal de 16MHz y el PLL.
+ * Si el oscilador principal no arranca se queda en el PIOSC, y si el PLL no cierra se queda en
+ * el oscilador sin dividir; en los dos casos a 16MHz y devuelve false. Reloj_Frecuencia da la
+ * frecuencia que quedo.
+ */
+bool Reloj_Init(void) {
+	// 0. Usar RCC2 para el PLL de 400MHz y el divisor extendido
+	SYSCTL_RCC2_R |= SYSCTL_RCC2_USERCC2;
+
+	// 1. Hacer bypass del PLL mientras se configura
+	SYSCTL_RCC2_R |= SYSCTL_RCC2_BYPASS2;
+
+	// 2. Encender el oscilador principal y seleccionar el cristal de 16MHz
+	SYSCTL_MISC_R = SYSCTL_MISC_MOSCPUPMIS;
+	SYSCTL_RCC_R = (SYSCTL_RCC_R & ~(SYSCTL_RCC_XTAL_M | SYSCTL_RCC_MOSCDIS)) | SYSCTL_RCC_XTAL_16MHZ;
+	if (!Reloj_Esperar(SYSCTL_RIS_MOSCPUPRIS)) {
+		SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~SYSCTL_RCC2_OSCSRC2_M) | SYSCTL_RCC2_OSCSRC2_IO;
+		SYSCTL_RCC_R &= ~SYSCTL_RCC_USESYSDIV;
+		relojes.oscilador = RELOJ_CRISTAL;
+		Reloj_Arbol(RELOJ_CRISTAL, false);
+		return false;
+	}
+	SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~SYSCTL_RCC2_OSCSRC2_M) | SYSCTL_RCC2_OSCSRC2_MO;
+
+	return Reloj_PLL();
+}
+
+/*
+ * Pasa al PLL con el divisor de RELOJ_SISTEMA (pasos 3 a 6, el oscilador ya debe estar listo).
+ * Si el PLL no cierra se queda en el oscilador a 16MHz y devuelve false.
+ */
+bool Reloj_PLL(void) {
+	SYSCTL_RCC2_R |= SYSCTL_RCC2_BYPASS2;
+
+	// 3. Encender el PLL
+	SYSCTL_MISC_R = SYSCTL_MISC_PLLLMIS;
+	SYSCTL_RCC2_R &= ~SYSCTL_RCC2_PWRDN2;
+
+	// 4. Divisor calculado en reloj.h
+	SYSCTL_RCC2_R = (SYSCTL_RCC2_R & ~(SYSCTL_RCC2_DIV400 | SYSCTL_RCC2_SYSDIV2_M | SYSCTL_RCC2_SYSDIV2LSB)) |
+			(RELOJ_DIV400 ? SYSCTL_RCC2_DIV400 : 0) |
+			((uint32_t)RELOJ_SYSDIV2 << SYSCTL_RCC2_SYSDIV2_S) |
+			(RELOJ_SYSDIV2LSB ? SYSCTL_RCC2_SYSDIV2LSB : 0);
+	SYSCTL_RCC_R |= SYSCTL_RCC_USESYSDIV;
+
+	// 5. Esperar a que el PLL cierre (PLLLRIS), con limite
+	if (!Reloj_Esperar(SYSCTL_RIS_PLLLRIS)) {
+		// Sin PLL: el divisor se aplicaria al cristal, quitarlo
+		SYSCTL_RCC_R &= ~SYSCTL_RCC_USESYSDIV;
+		SYSCTL_RCC2_R |= SYSCTL_RCC2_PWRDN2;
+		Reloj_Arbol(RELOJ_CRISTAL, false);
+		return false;
+	}
+
+	// 6. Quitar el bypass
+	SYSCTL_RCC2_R &= ~SYSCTL_RCC2_BYPASS2;
+	Reloj_Arbol(RELOJ_SISTEMA, true);
+	return true;
+}
+
+/*
+ * Pasa al oscilador (16MHz) sin divisor y apaga el PLL
+ */
+void Reloj_Oscilador(void) {
+	SYSCTL_RCC2_R |= SYSCTL_RCC2_BYPASS2;
+	SYSCTL_RCC_R &= ~SYSCTL_RCC_USESYSDIV;
+	SYSCTL_RCC2_R |= SYSCTL_RCC2_PWRDN2;
+	Reloj_Arbol(RELOJ_CRISTAL, false);
+}
+
+uint32_t Reloj_Frecuencia(void) {
+	return relojes.sistema;
+}
+
+/*
+ * Llena el arbol decodificando RCC/RCC2 una vez, para los proyectos que configuran el reloj con
+ * SysCtlClockSet. El oscilador principal se toma como el cristal de 16MHz del Launchpad.
+ */
+void Reloj_Leer(void) {
+	uint32_t rcc = SYSCTL_RCC_R, rcc2 = SYSCTL_RCC2_R, fuente, divisor, pll;
+	bool bypass, usarDivisor = (rcc & SYSCTL_RCC_USESYSDIV) != 0;
+
+	if (rcc2 & SYSCTL_RCC2_USERCC2) {
+		fuente = rcc2 & SYSCTL_RCC2_OSCSRC2_M;
+		bypass = (rcc2 & SYSCTL_RCC2_BYPASS2) != 0;
+		divisor = (rcc2 & SYSCTL_RCC2_SYSDIV2_M) >> SYSCTL_RCC2_SYSDIV2_S;
+		if (rcc2 & SYSCTL_RCC2_DIV400) {
+			divisor = (divisor << 1) | ((rcc2 & SYSCTL_RCC2_SYSDIV2LSB) ? 1 : 0);
+			pll = RELOJ_PLL;
+		} else {
+			pll = RELOJ_PLL / 2;
+		}
+		relojes.oscilador = (fuente == SYSCTL_RCC2_OSCSRC2_IO4) ? RELOJ_CRISTAL / 4 :
+				(fuente == SYSCTL_RCC2_OSCSRC2_30) ? 30000 :
+				(fuente == SYSCTL_RCC2_OSCSRC2_32) ? 32768 : RELOJ_CRISTAL;
+	} else {
+		fuente = rcc & SYSCTL_RCC_OSCSRC_M;
+		bypass = (rcc & SYSCTL_RCC_BYPASS) != 0;
+		divisor = (rcc & SYSCTL_RCC_SYSDIV_M) >> SYSCTL_RCC_SYSDIV_S;
+		pll = RELOJ_PLL / 2;
+		relojes.oscilador = (fuente == SYSCTL_RCC_OSCSRC_INT4) ? RELOJ_CRISTAL / 4 :
+				(fuente == SYSCTL_RCC_OSCSRC_30) ? 30000 : RELOJ_CRISTAL;
+	}
+
+	// Con el PLL el divisor siempre se aplica (USESYSDIV lo fuerza el hardware)
+	if (!bypass) {
+		Reloj_Arbol(pll / (divisor + 1), true);
+	} else {
+		Reloj_Arbol(usarDivisor ? relojes.oscilador / (divisor + 1) : relojes.oscilador, false);
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * reloj.h
+ *
+ * Configuracion del reloj del sistema con el PLL para cualquier frecuencia, con registros.
+ *
+ * El proyecto define RELOJ_OBJETIVO (Hz) antes de incluir este encabezado, por defecto 80MHz.
+ * El divisor del PLL de 400MHz se calcula en tiempo de compilacion, redondeado hacia arriba para
+ * no pasar del objetivo, y RELOJ_SISTEMA queda como la frecuencia que resulta, de modo que
+ * retardo.h y los calculos de cada proyecto usan la frecuencia real:
+ *  - divisor par: sin DIV400, f = 200MHz / (SYSDIV2 + 1)
+ *  - divisor impar: con DIV400, f = 400MHz / (SYSDIV2:SYSDIV2LSB + 1)
+ * El divisor va de 5 (80MHz) a 128 (3.125MHz).
+ *
+ * Arbol de relojes: relojes guarda las frecuencias que usan los perifericos, calculadas una sola
+ * vez despues de configurar el reloj (Reloj_Init, Reloj_PLL, Reloj_Oscilador o Reloj_Leer para
+ * los proyectos que usan SysCtlClockSet), para no decodificar RCC/RCC2 con SysCtlClockGet en cada
+ * inicializacion. Con un reloj fijo los divisores se calculan en tiempo de compilacion con
+ * RELOJ_SISTEMA (divisor.h).
+ */
+
+#ifndef RELOJ_H_
+#define RELOJ_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef RELOJ_OBJETIVO
+#define RELOJ_OBJETIVO		80000000
+#endif
+
+#define RELOJ_PLL			400000000
+#define RELOJ_CRISTAL		16000000		// cristal del Launchpad y PIOSC
+#define RELOJ_DIVISOR		((RELOJ_PLL + RELOJ_OBJETIVO - 1) / RELOJ_OBJETIVO)
+#define RELOJ_DIV400		(RELOJ_DIVISOR & 1)
+#define RELOJ_SYSDIV2		(RELOJ_DIV400 ? ((RELOJ_DIVISOR - 1) >> 1) : ((RELOJ_DIVISOR >> 1) - 1))
+#define RELOJ_SYSDIV2LSB	(RELOJ_DIV400 ? ((RELOJ_DIVISOR - 1) & 1) : 0)
+
+#ifndef RELOJ_SISTEMA
+#define RELOJ_SISTEMA		(RELOJ_PLL / RELOJ_DIVISOR)
+#endif
+
+// Ciclos de espera (a 16MHz) del oscilador principal y del cierre del PLL antes de rendirse
+#define RELOJ_ESPERA		100000
+
+typedef char reloj_divisorValido[(RELOJ_DIVISOR >= 5 && RELOJ_DIVISOR <= 128) ? 1 : -1];
+typedef char reloj_sistemaExacto[(RELOJ_SISTEMA == RELOJ_PLL / RELOJ_DIVISOR) ? 1 : -1];
+
+// Frecuencias del arbol de relojes en Hz
+struct arbolReloj {
+	uint32_t sistema;		// SysClk: CPU, UART, SSI, timers
+	uint32_t oscilador;		// fuente del PLL o de SysClk con bypass
+	uint32_t pwm;			// reloj del modulo PWM (SysClk / PWMDIV)
+	bool pll;				// SysClk sale del PLL
+};
+
+typedef struct arbolReloj t_arbolReloj;
+
+extern t_arbolReloj relojes;
+
+bool Reloj_Init(void);
+bool Reloj_PLL(void);
+void Reloj_Oscilador(void);
+uint32_t Reloj_Frecuencia(void);
+void Reloj_Leer(void);
+
+#endif /* RELOJ_H_ */
@@ -0,0 +1,152 @@
+/*
+ * reposo.c
+ *
+ * Reposo con WFI y reposo sin tick, ver reposo.h
+ */
+
+#include "reposo.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_timer.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/interrupt.h"
+
+// Ciclos minimos que le deben quedar al tick para alargarlo, cubren la lectura y escritura del contador
+#define REPOSO_MARGEN	64
+
+static uint32_t timer = 0;				// base del timer periodico, 0 sin medicion
+static uint32_t carga;					// ciclos por periodo del timer
+static uint32_t salida;					// valor del contador al despertar
+static t_proximoTick proximoTick = 0;
+static t_avanzarTick avanzarTick = 0;
+static t_estadisticasReposo estadisticas;
+
+#define CONTADOR()	HWREG(timer + TIMER_O_TAV)
+
+/*
+ * Ciclos entre dos lecturas del contador, con a lo sumo una recarga en medio
+ */
+static uint32_t Reposo_Ciclos(uint32_t desde, uint32_t hasta) {
+	return (desde >= hasta) ? (desde - hasta) : (desde + carga - hasta);
+}
+
+/*
+ * Activa el gating de relojes en sleep y toma el timer periodico ya configurado (0 para no medir)
+ */
+void Reposo_Init(uint32_t timerBase) {
+	SysCtlPeripheralClockGating(true);
+
+	timer = timerBase;
+	if (timer != 0) {
+		carga = TimerLoadGet(timer, TIMER_A) + 1;
+		salida = CONTADOR();
+	}
+	proximoTick = 0;
+	avanzarTick = 0;
+	estadisticas.entradas = 0;
+	estadisticas.ciclosDormido = 0;
+	estadisticas.ciclosActivo = 0;
+	estadisticas.residencia = 0;
+	estadisticas.ticksOmitidos = 0;
+	estadisticas.maxOmitidos = 0;
+}
+
+/*
+ * Vuelve a leer la carga del timer despues de cambiarla (escalado de frecuencia)
+ */
+void Reposo_CambiarCarga(void) {
+	if (timer != 0) {
+		carga = TimerLoadGet(timer, TIMER_A) + 1;
+		salida = CONTADOR();
+	}
+}
+
+/*
+ * Activa el reposo sin tick. El timer de Reposo_Init debe ser el tick, con su interrupcion de
+ * timeout habilitada, y su rutina debe llamar a avanzar() una vez.
+ */
+void Reposo_SinTick(t_proximoTick proximo, t_avanzarTick avanzar) {
+	proximoTick = proximo;
+	avanzarTick = avanzar;
+}
+
+/*
+ * Duerme hasta la siguiente interrupcion, que se atiende antes de regresar. El WFI se ejecuta con
+ * las interrupciones deshabilitadas para que no se pierda una que llegue justo antes de dormir;
+ * una interrupcion pendiente lo despierta igual.
+ */
+void Reposo_Esperar(void) {
+	uint32_t entrada = 0, despertar, libres = 0, omitidos = 0;
+
+	IntMasterDisable();
+
+	if (timer != 0) {
+		entrada = CONTADOR();
+		estadisticas.ciclosActivo += Reposo_Ciclos(salida, entrada);
+
+		// Alargar el tick actual con los ticks que no tienen trabajo
+		if (proximoTick != 0 && entrada > REPOSO_MARGEN &&
+				(TimerIntStatus(timer, false) & TIMER_TIMA_TIMEOUT) == 0) {
+			libres = proximoTick() - 1;
+			if (libres > (0xffffffff - entrada) / carga) {
+				libres = (0xffffffff - entrada) / carga;
+			}
+			if (libres > 0) {
+				// Se pierden los pocos ciclos entre la lectura y la escritura del contador
+				entrada += libres * carga;
+				CONTADOR() = entrada;
+			}
+		}
+	}
+
+	SysCtlSleep();
+	estadisticas.entradas++;
+
+	if (timer != 0) {
+		despertar = CONTADOR();
+		salida = despertar;
+
+		if (libres == 0) {
+			estadisticas.ciclosDormido += Reposo_Ciclos(entrada, despertar);
+		} else {
+			if ((TimerIntStatus(timer, false) & TIMER_TIMA_TIMEOUT) != 0) {
+				// Se cumplieron todos; la rutina del timer avanza el ultimo tick
+				estadisticas.ciclosDormido += entrada + carga - despertar;
+				omitidos = libres;
+			} else {
+				// Desperto otra interrupcion: avanzar los ticks completos y dejar el resto del actual
+				estadisticas.ciclosDormido += entrada - despertar;
+				omitidos = libres - despertar / carga;
+				salida = despertar % carga;
+				CONTADOR() = salida;
+			}
+			estadisticas.ticksOmitidos += omitidos;
+			if (omitidos > estadisticas.maxOmitidos) {
+				estadisticas.maxOmitidos = omitidos;
+			}
+			while (omitidos > 0) {
+				avanzarTick();
+				omitidos--;
+			}
+		}
+	}
+
+	IntMasterEnable();
+}
+
+/*
+ * Copia las estadisticas y calcula la residencia en sleep
+ */
+void Reposo_Estadisticas(t_estadisticasReposo *e) {
+	bool deshabilitadas = IntMasterDisable();
+	uint64_t total;
+
+	*e = estadisticas;
+	if (!deshabilitadas) {
+		IntMasterEnable();
+	}
+
+	total = e->ciclosDormido + e->ciclosActivo;
+	e->residencia = (total != 0) ? (uint32_t)((e->ciclosDormido * 1000) / total) : 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * reposo.h
+ *
+ * Reposo del programa principal: en lugar de un while(1) vacio, Reposo_Esperar duerme el nucleo
+ * con WFI (modo sleep) hasta la siguiente interrupcion. Reposo_Init activa el gating de relojes
+ * en sleep, por lo que solo siguen funcionando los perifericos habilitados con
+ * SysCtlPeripheralSleepEnable; cada proyecto habilita los que usan sus interrupciones.
+ *
+ * El tiempo dormido y activo se mide con el contador del timer periodico del proyecto (Timer A,
+ * 32 bits, contando hacia abajo). El tiempo activo entre dos reposos se mide modulo un periodo del
+ * timer, asi que las estadisticas solo son exactas si el programa principal no hace nada mas.
+ *
+ * Sin tick: si el timer es el tick de una rueda de temporizadores, Reposo_SinTick recibe la funcion
+ * que da los ticks hasta el proximo vencimiento y la que avanza un tick. Antes de dormir se alarga
+ * la cuenta del timer para saltar los ticks sin trabajo y al despertar se avanzan los ticks que
+ * pasaron y se vuelve a alinear el contador con el tick.
+ */
+
+#ifndef REPOSO_H_
+#define REPOSO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint32_t (*t_proximoTick)(void);
+typedef void (*t_avanzarTick)(void);
+
+struct estadisticasReposo {
+	uint32_t entradas;			// veces que se durmio
+	uint64_t ciclosDormido;		// ciclos del reloj del sistema en sleep
+	uint64_t ciclosActivo;		// ciclos despiertos entre reposos (interrupciones)
+	uint32_t residencia;		// tiempo dormido en partes por mil
+	uint32_t ticksOmitidos;		// ticks sin interrupcion por el reposo sin tick
+	uint32_t maxOmitidos;		// mayor numero de ticks omitidos en un reposo
+};
+
+typedef struct estadisticasReposo t_estadisticasReposo;
+
+void Reposo_Init(uint32_t timerBase);
+void Reposo_CambiarCarga(void);
+void Reposo_SinTick(t_proximoTick proximo, t_avanzarTick avanzar);
+void Reposo_Esperar(void);
+void Reposo_Estadisticas(t_estadisticasReposo *e);
+
+#endif /* REPOSO_H_ */
@@ -0,0 +1,48 @@
+/*
+ * retardo.h
+ *
+ * Retardos en microsegundos y milisegundos que no dependen de constantes calculadas a mano.
+ *
+ * Si el proyecto define RELOJ_SISTEMA (Hz) antes de incluir este encabezado, RETARDO_US se
+ * convierte en tiempo de compilacion en las iteraciones de SysCtlDelay (3 ciclos cada una) y
+ * CICLOS_US da los ciclos para cargar timers; RELOJ_SISTEMA debe coincidir con SysCtlClockSet.
+ * Sin RELOJ_SISTEMA, o con RELOJ_DINAMICO (reloj que cambia en ejecucion, escalado.c), RETARDO_US
+ * espera sobre la base de tiempo de tiempo.c, que debe estar iniciada con el reloj actual.
+ *
+ * SysCtlDelay ejecuta desde flash: con estados de espera (arriba de 40MHz) o interrupciones el
+ * retardo es mas largo que el pedido, nunca mas corto. La base de tiempo no tiene ese error.
+ */
+
+#ifndef RETARDO_H_
+#define RETARDO_H_
+
+#include <stdint.h>
+#include "driverlib/sysctl.h"
+
+#if defined(RELOJ_SISTEMA) && !defined(RELOJ_DINAMICO)
+
+// Ciclos del reloj del sistema en us microsegundos
+#define CICLOS_US(us)			((uint32_t)(((uint64_t)(us) * RELOJ_SISTEMA) / 1000000))
+// Iteraciones de SysCtlDelay, minimo 1 (con 0 daria 2^32 vueltas)
+#define RETARDO_ITERACIONES(us)	((CICLOS_US(us) >= 3) ? (CICLOS_US(us) / 3) : 1)
+#define RETARDO_US(us)			SysCtlDelay(RETARDO_ITERACIONES(us))
+
+#else
+
+#include "tiempo.h"
+
+static inline void Retardo_Us(uint32_t us) {
+	uint64_t limite = Tiempo_Limite(us);
+
+	while (!Tiempo_Vencido(limite)) {
+	}
+}
+
+#define CICLOS_US(us)			((uint32_t)Tiempo_UsACiclos(us))
+#define RETARDO_US(us)			Retardo_Us(us)
+
+#endif
+
+#define RETARDO_MS(ms)			RETARDO_US((uint32_t)(ms) * 1000)
+
+#endif /* RETARDO_H_ */
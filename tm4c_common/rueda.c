@@ -0,0 +1,184 @@
+/*
+ * rueda.c
+ *
+ * Rueda de temporizadores por software, ver rueda.h
+ *
+ * Con RUEDA_HOST (programas de tm4c_hostSim) IntMasterDisable/IntMasterEnable solo llevan el estado
+ * de las interrupciones en ruedaHostDeshabilitadas.
+ */
+
+#include "rueda.h"
+
+#ifdef RUEDA_HOST
+volatile bool ruedaHostDeshabilitadas = false;
+
+static bool IntMasterDisable(void) {
+	bool antes = ruedaHostDeshabilitadas;
+
+	ruedaHostDeshabilitadas = true;
+	return antes;
+}
+
+static bool IntMasterEnable(void) {
+	bool antes = ruedaHostDeshabilitadas;
+
+	ruedaHostDeshabilitadas = false;
+	return antes;
+}
+#else
+#include "driverlib/interrupt.h"
+#endif
+
+// Listas circulares con nodo centinela: un temporizador se desenlaza sin conocer su lista
+struct listaTemporizadores {
+	t_temporizador *sig;
+	t_temporizador *ant;
+};
+
+static struct listaTemporizadores ranuras[RUEDA_RANURAS];
+static struct listaTemporizadores pendientes;		// ranura que se esta procesando en el tick
+static volatile uint32_t ahora = 0;
+
+#define CENTINELA(l)	((t_temporizador *)(l))
+
+/*
+ * Enlaza t al final de la lista l
+ */
+static void Rueda_Enlazar(struct listaTemporizadores *l, t_temporizador *t) {
+	t->sig = CENTINELA(l);
+	t->ant = l->ant;
+	l->ant->sig = t;
+	l->ant = t;
+}
+
+static void Rueda_Desenlazar(t_temporizador *t) {
+	t->ant->sig = t->sig;
+	t->sig->ant = t->ant;
+	t->sig = t;
+	t->ant = t;
+}
+
+void Rueda_Init(void) {
+	uint32_t i;
+
+	for (i = 0; i < RUEDA_RANURAS; i++) {
+		ranuras[i].sig = CENTINELA(&ranuras[i]);
+		ranuras[i].ant = CENTINELA(&ranuras[i]);
+	}
+	pendientes.sig = CENTINELA(&pendientes);
+	pendientes.ant = CENTINELA(&pendientes);
+	ahora = 0;
+}
+
+/*
+ * Inicia (o reinicia) t para que llame a funcion(arg) dentro de "retardo" ticks (minimo 1) y luego
+ * cada "periodo" ticks; con periodo 0 se llama una sola vez. Se puede llamar desde una funcion de
+ * la rueda, incluso para el mismo temporizador.
+ */
+void Rueda_Iniciar(t_temporizador *t, uint32_t retardo, uint32_t periodo, t_funcionTemporizador funcion, void *arg) {
+	bool deshabilitadas = IntMasterDisable();
+
+	if (t->activo) {
+		Rueda_Desenlazar(t);
+	}
+	if (retardo == 0) {
+		retardo = 1;
+	}
+	t->vencimiento = ahora + retardo;
+	t->periodo = periodo;
+	t->funcion = funcion;
+	t->arg = arg;
+	t->activo = true;
+	Rueda_Enlazar(&ranuras[t->vencimiento & (RUEDA_RANURAS - 1)], t);
+
+	if (!deshabilitadas) {
+		IntMasterEnable();
+	}
+}
+
+/*
+ * Detiene t, no hace nada si no estaba activo
+ */
+void Rueda_Cancelar(t_temporizador *t) {
+	bool deshabilitadas = IntMasterDisable();
+
+	if (t->activo) {
+		Rueda_Desenlazar(t);
+		t->activo = false;
+	}
+
+	if (!deshabilitadas) {
+		IntMasterEnable();
+	}
+}
+
+bool Rueda_Activo(const t_temporizador *t) {
+	return t->activo;
+}
+
+/*
+ * Ticks desde Rueda_Init
+ */
+uint32_t Rueda_Ahora(void) {
+	return ahora;
+}
+
+/*
+ * Ticks hasta el proximo vencimiento, de 1 a RUEDA_RANURAS (sin temporizadores en la siguiente
+ * vuelta devuelve RUEDA_RANURAS). Recorre hasta una vuelta de ranuras, es para el reposo sin tick
+ * y se debe llamar con las interrupciones deshabilitadas.
+ */
+uint32_t Rueda_Proximo(void) {
+	struct listaTemporizadores *ranura;
+	t_temporizador *t;
+	uint32_t d;
+
+	for (d = 1; d < RUEDA_RANURAS; d++) {
+		ranura = &ranuras[(ahora + d) & (RUEDA_RANURAS - 1)];
+		for (t = ranura->sig; t != CENTINELA(ranura); t = t->sig) {
+			if (t->vencimiento == ahora + d) {
+				return d;
+			}
+		}
+	}
+	return RUEDA_RANURAS;
+}
+
+/*
+ * Avanza un tick y llama a los temporizadores que vencen. Llamar desde la interrupcion del tick.
+ */
+void Rueda_Tick(void) {
+	struct listaTemporizadores *ranura;
+	t_temporizador *t;
+
+	ahora += 1;
+	ranura = &ranuras[ahora & (RUEDA_RANURAS - 1)];
+	if (ranura->sig == CENTINELA(ranura)) {
+		return;
+	}
+
+	// Pasar la ranura a la lista de pendientes, asi las funciones pueden iniciar o cancelar
+	// cualquier temporizador (incluso los que faltan por revisar) mientras se recorre
+	pendientes.sig = ranura->sig;
+	pendientes.ant = ranura->ant;
+	pendientes.sig->ant = CENTINELA(&pendientes);
+	pendientes.ant->sig = CENTINELA(&pendientes);
+	ranura->sig = CENTINELA(ranura);
+	ranura->ant = CENTINELA(ranura);
+
+	while (pendientes.sig != CENTINELA(&pendientes)) {
+		t = pendientes.sig;
+		Rueda_Desenlazar(t);
+		if (t->vencimiento != ahora) {
+			// Vence en una vuelta posterior
+			Rueda_Enlazar(ranura, t);
+		} else if (t->periodo != 0) {
+			t->vencimiento += t->periodo;
+			Rueda_Enlazar(&ranuras[t->vencimiento & (RUEDA_RANURAS - 1)], t);
+			t->funcion(t->arg);
+		} else {
+			t->activo = false;
+			t->funcion(t->arg);
+		}
+	}
+}
@@ -0,0 +1,51 @@
+/*
+ * rueda.h
+ *
+ * Rueda de temporizadores por software sobre un solo tick de hardware (SysTick o un GPTM).
+ * Cada temporizador cae en la ranura (vencimiento % RUEDA_RANURAS), una lista doblemente enlazada,
+ * por lo que iniciar y cancelar son O(1) y cada tick solo revisa una ranura. Los temporizadores con
+ * retardo mayor que RUEDA_RANURAS se quedan en su ranura hasta la vuelta en que vencen.
+ *
+ * Los temporizadores los reserva quien los usa (variables globales o estaticas), no hay memoria
+ * dinamica, asi que la cantidad solo esta limitada por la RAM; deben empezar en cero (globales).
+ * Las funciones se llaman dentro de la interrupcion del tick y deben ser cortas. Rueda_Iniciar y
+ * Rueda_Cancelar se pueden llamar desde el programa principal, desde las funciones de la rueda o
+ * desde interrupciones con prioridad igual o menor que la del tick.
+ */
+
+#ifndef RUEDA_H_
+#define RUEDA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Numero de ranuras, potencia de 2
+#define RUEDA_RANURAS	256
+
+typedef void (*t_funcionTemporizador)(void *arg);
+
+struct temporizador {
+	struct temporizador *sig;
+	struct temporizador *ant;
+	uint32_t vencimiento;			// tick absoluto en que vence
+	uint32_t periodo;				// 0 para un solo disparo
+	t_funcionTemporizador funcion;
+	void *arg;
+	bool activo;
+};
+
+typedef struct temporizador t_temporizador;
+
+#ifdef RUEDA_HOST
+extern volatile bool ruedaHostDeshabilitadas;
+#endif
+
+void Rueda_Init(void);
+void Rueda_Iniciar(t_temporizador *t, uint32_t retardo, uint32_t periodo, t_funcionTemporizador funcion, void *arg);
+void Rueda_Cancelar(t_temporizador *t);
+bool Rueda_Activo(const t_temporizador *t);
+uint32_t Rueda_Ahora(void);
+uint32_t Rueda_Proximo(void);
+void Rueda_Tick(void);
+
+#endif /* RUEDA_H_ */
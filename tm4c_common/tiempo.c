@@ -0,0 +1,64 @@
+/*
+ * tiempo.c
+ *
+ * Base de tiempo de 64 bits con el Wide Timer 5, ver tiempo.h
+ */
+
+#include "tiempo.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+static uint32_t relojTiempo = 1000000;		// Hz, para las conversiones a microsegundos
+
+/*
+ * Configura el Wide Timer 5 como un contador de 64 bits hacia arriba y lo inicia en cero.
+ * Sigue contando en sleep y no se detiene con el depurador para que el tiempo sea monotono.
+ */
+void Tiempo_Init(uint32_t relojSistema) {
+	SysCtlPeripheralEnable(TIEMPO_PERIFERICO);
+	SysCtlPeripheralSleepEnable(TIEMPO_PERIFERICO);
+	while (!SysCtlPeripheralReady(TIEMPO_PERIFERICO)) {
+	}
+
+	TimerDisable(TIEMPO_TIMER, TIMER_BOTH);
+	TimerConfigure(TIEMPO_TIMER, TIMER_CFG_PERIODIC_UP);	// 64 bits en un wide timer
+	TimerLoadSet64(TIEMPO_TIMER, 0xffffffffffffffffULL);
+	TimerControlStall(TIEMPO_TIMER, TIMER_A, false);
+	TimerEnable(TIEMPO_TIMER, TIMER_A);
+
+	relojTiempo = relojSistema;
+}
+
+/*
+ * Actualiza la conversion a microsegundos despues de cambiar el reloj con SysCtlClockSet. La
+ * cuenta en ciclos sigue siendo monotona, pero mezcla ciclos de los dos relojes.
+ */
+void Tiempo_CambiarReloj(uint32_t relojSistema) {
+	relojTiempo = relojSistema;
+}
+
+/*
+ * Ciclos a microsegundos sin truncar el reloj a MHz enteros. Los segundos completos se separan
+ * para que ciclos * 1000000 no se desborde.
+ */
+uint64_t Tiempo_CiclosAUs(uint64_t ciclos) {
+	return (ciclos / relojTiempo) * 1000000 + ((ciclos % relojTiempo) * 1000000) / relojTiempo;
+}
+
+/*
+ * Microsegundos desde Tiempo_Init
+ */
+uint64_t Tiempo_Us(void) {
+	return Tiempo_CiclosAUs(Tiempo_Ciclos());
+}
+
+uint64_t Tiempo_UsACiclos(uint32_t us) {
+	return ((uint64_t)us * relojTiempo) / 1000000;
+}
+
+/*
+ * Limite para Tiempo_Vencido dentro de us microsegundos
+ */
+uint64_t Tiempo_Limite(uint32_t us) {
+	return Tiempo_Ciclos() + Tiempo_UsACiclos(us);
+}
@@ -0,0 +1,57 @@
+/*
+ * tiempo.h
+ *
+ * Base de tiempo monotona de 64 bits con el Wide Timer 5 concatenado (WTimer5A parte baja,
+ * WTimer5B parte alta) contando hacia arriba con el reloj del sistema. A 80MHz da la vuelta en
+ * mas de 7000 anos, asi que no hay desbordes que atender ni interrupciones.
+ *
+ * Tiempo_Ciclos lee alto, bajo y otra vez alto hasta que las dos lecturas de la parte alta
+ * coinciden, por lo que se puede llamar desde el programa principal y desde cualquier
+ * interrupcion sin secciones criticas (una interrupcion entre lecturas solo causa un reintento).
+ * Son unas cuantas lecturas del bus, sin division; Tiempo_Us divide entre 64 bits.
+ *
+ * Las conversiones entre ciclos y microsegundos usan el reloj en Hz (ciclos * 1000000 / reloj y
+ * us * reloj / 1000000), exactas tambien con relojes que no son MHz enteros (66.67MHz).
+ */
+
+#ifndef TIEMPO_H_
+#define TIEMPO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_timer.h"
+
+#define TIEMPO_TIMER		WTIMER5_BASE
+#define TIEMPO_PERIFERICO	SYSCTL_PERIPH_WTIMER5
+
+void Tiempo_Init(uint32_t relojSistema);
+void Tiempo_CambiarReloj(uint32_t relojSistema);
+uint64_t Tiempo_CiclosAUs(uint64_t ciclos);
+uint64_t Tiempo_Us(void);
+uint64_t Tiempo_UsACiclos(uint32_t us);
+uint64_t Tiempo_Limite(uint32_t us);
+
+/*
+ * Ciclos del reloj del sistema desde Tiempo_Init
+ */
+static inline uint64_t Tiempo_Ciclos(void) {
+	uint32_t alto, bajo;
+
+	do {
+		alto = HWREG(TIEMPO_TIMER + TIMER_O_TBV);
+		bajo = HWREG(TIEMPO_TIMER + TIMER_O_TAV);
+	} while (alto != HWREG(TIEMPO_TIMER + TIMER_O_TBV));
+
+	return ((uint64_t)alto << 32) | bajo;
+}
+
+/*
+ * true si ya se llego al limite (de Tiempo_Limite o Tiempo_Ciclos() + n)
+ */
+static inline bool Tiempo_Vencido(uint64_t limite) {
+	return Tiempo_Ciclos() >= limite;
+}
+
+#endif /* TIEMPO_H_ */
@@ -0,0 +1,445 @@
+//*****************************************************************************
+//
+// Startup code for use with TI's Code Composer Studio.
+//
+// Archivo de arranque compartido por todos los proyectos (enlazado desde
+// tm4c_common en cada .project). Sirve tambien para el LM4F120H5QR, que tiene
+// la misma tabla de vectores.
+//
+// Copyright (c) 2011-2013 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Software License Agreement
+//
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+
+//*****************************************************************************
+//
+// Forward declaration of the default fault handlers.
+//
+//*****************************************************************************
+void ResetISR(void);
+static void NmiSR(void);
+static void FaultISR(void);
+void IntDefaultHandler(void);
+
+//*****************************************************************************
+//
+// External declaration for the reset handler that is to be called when the
+// processor is started
+//
+//*****************************************************************************
+extern void _c_int00(void);
+
+//*****************************************************************************
+//
+// Gancho de ResetISR antes de _c_int00, vacio salvo que se enlace arranque.c
+// (marcas de tiempo del arranque). Solo puede usar la pila.
+//
+//*****************************************************************************
+void Arranque_Reset(void) __attribute__((weak));
+
+//*****************************************************************************
+//
+// Linker variable that marks the top of the stack.
+//
+//*****************************************************************************
+extern uint32_t __STACK_TOP;
+
+//*****************************************************************************
+//
+// External declarations for the interrupt handlers used by the application.
+//
+//*****************************************************************************
+// Cada manejador es un alias debil de IntDefaultHandler: la aplicacion lo reemplaza definiendo
+// una funcion con el mismo nombre (Int_Timer0A_Handler, Int_UART0_Handler...), sin editar la
+// tabla. Un nombre mal escrito no da error de enlace, la interrupcion cae en IntDefaultHandler.
+#define DEBIL   __attribute__((weak, alias("IntDefaultHandler")))
+
+void Int_MPUFault_Handler(void) DEBIL;
+void Int_BusFault_Handler(void) DEBIL;
+void Int_UsageFault_Handler(void) DEBIL;
+void Int_SVCall_Handler(void) DEBIL;
+void Int_DebugMon_Handler(void) DEBIL;
+void Int_PendSV_Handler(void) DEBIL;
+void Int_SysTick_Handler(void) DEBIL;
+void Int_GPIOA_Handler(void) DEBIL;
+void Int_GPIOB_Handler(void) DEBIL;
+void Int_GPIOC_Handler(void) DEBIL;
+void Int_GPIOD_Handler(void) DEBIL;
+void Int_GPIOE_Handler(void) DEBIL;
+void Int_UART0_Handler(void) DEBIL;
+void Int_UART1_Handler(void) DEBIL;
+void Int_SSI0_Handler(void) DEBIL;
+void Int_I2C0_Handler(void) DEBIL;
+void Int_PWM0Fault_Handler(void) DEBIL;
+void Int_PWM0Gen0_Handler(void) DEBIL;
+void Int_PWM0Gen1_Handler(void) DEBIL;
+void Int_PWM0Gen2_Handler(void) DEBIL;
+void Int_QEI0_Handler(void) DEBIL;
+void Int_ADC0SS0_Handler(void) DEBIL;
+void Int_ADC0SS1_Handler(void) DEBIL;
+void Int_ADC0SS2_Handler(void) DEBIL;
+void Int_ADC0SS3_Handler(void) DEBIL;
+void Int_Watchdog_Handler(void) DEBIL;
+void Int_Timer0A_Handler(void) DEBIL;
+void Int_Timer0B_Handler(void) DEBIL;
+void Int_Timer1A_Handler(void) DEBIL;
+void Int_Timer1B_Handler(void) DEBIL;
+void Int_Timer2A_Handler(void) DEBIL;
+void Int_Timer2B_Handler(void) DEBIL;
+void Int_Comp0_Handler(void) DEBIL;
+void Int_Comp1_Handler(void) DEBIL;
+void Int_Comp2_Handler(void) DEBIL;
+void Int_SysCtl_Handler(void) DEBIL;
+void Int_Flash_Handler(void) DEBIL;
+void Int_GPIOF_Handler(void) DEBIL;
+void Int_GPIOG_Handler(void) DEBIL;
+void Int_GPIOH_Handler(void) DEBIL;
+void Int_UART2_Handler(void) DEBIL;
+void Int_SSI1_Handler(void) DEBIL;
+void Int_Timer3A_Handler(void) DEBIL;
+void Int_Timer3B_Handler(void) DEBIL;
+void Int_I2C1_Handler(void) DEBIL;
+void Int_QEI1_Handler(void) DEBIL;
+void Int_CAN0_Handler(void) DEBIL;
+void Int_CAN1_Handler(void) DEBIL;
+void Int_Hibernate_Handler(void) DEBIL;
+void Int_USB0_Handler(void) DEBIL;
+void Int_PWM0Gen3_Handler(void) DEBIL;
+void Int_uDMA_Handler(void) DEBIL;
+void Int_uDMAErr_Handler(void) DEBIL;
+void Int_ADC1SS0_Handler(void) DEBIL;
+void Int_ADC1SS1_Handler(void) DEBIL;
+void Int_ADC1SS2_Handler(void) DEBIL;
+void Int_ADC1SS3_Handler(void) DEBIL;
+void Int_GPIOJ_Handler(void) DEBIL;
+void Int_GPIOK_Handler(void) DEBIL;
+void Int_GPIOL_Handler(void) DEBIL;
+void Int_SSI2_Handler(void) DEBIL;
+void Int_SSI3_Handler(void) DEBIL;
+void Int_UART3_Handler(void) DEBIL;
+void Int_UART4_Handler(void) DEBIL;
+void Int_UART5_Handler(void) DEBIL;
+void Int_UART6_Handler(void) DEBIL;
+void Int_UART7_Handler(void) DEBIL;
+void Int_I2C2_Handler(void) DEBIL;
+void Int_I2C3_Handler(void) DEBIL;
+void Int_Timer4A_Handler(void) DEBIL;
+void Int_Timer4B_Handler(void) DEBIL;
+void Int_Timer5A_Handler(void) DEBIL;
+void Int_Timer5B_Handler(void) DEBIL;
+void Int_WTimer0A_Handler(void) DEBIL;
+void Int_WTimer0B_Handler(void) DEBIL;
+void Int_WTimer1A_Handler(void) DEBIL;
+void Int_WTimer1B_Handler(void) DEBIL;
+void Int_WTimer2A_Handler(void) DEBIL;
+void Int_WTimer2B_Handler(void) DEBIL;
+void Int_WTimer3A_Handler(void) DEBIL;
+void Int_WTimer3B_Handler(void) DEBIL;
+void Int_WTimer4A_Handler(void) DEBIL;
+void Int_WTimer4B_Handler(void) DEBIL;
+void Int_WTimer5A_Handler(void) DEBIL;
+void Int_WTimer5B_Handler(void) DEBIL;
+void Int_FPU_Handler(void) DEBIL;
+void Int_I2C4_Handler(void) DEBIL;
+void Int_I2C5_Handler(void) DEBIL;
+void Int_GPIOM_Handler(void) DEBIL;
+void Int_GPION_Handler(void) DEBIL;
+void Int_QEI2_Handler(void) DEBIL;
+void Int_GPIOP0_Handler(void) DEBIL;
+void Int_GPIOP1_Handler(void) DEBIL;
+void Int_GPIOP2_Handler(void) DEBIL;
+void Int_GPIOP3_Handler(void) DEBIL;
+void Int_GPIOP4_Handler(void) DEBIL;
+void Int_GPIOP5_Handler(void) DEBIL;
+void Int_GPIOP6_Handler(void) DEBIL;
+void Int_GPIOP7_Handler(void) DEBIL;
+void Int_GPIOQ0_Handler(void) DEBIL;
+void Int_GPIOQ1_Handler(void) DEBIL;
+void Int_GPIOQ2_Handler(void) DEBIL;
+void Int_GPIOQ3_Handler(void) DEBIL;
+void Int_GPIOQ4_Handler(void) DEBIL;
+void Int_GPIOQ5_Handler(void) DEBIL;
+void Int_GPIOQ6_Handler(void) DEBIL;
+void Int_GPIOQ7_Handler(void) DEBIL;
+void Int_GPIOR_Handler(void) DEBIL;
+void Int_GPIOS_Handler(void) DEBIL;
+void Int_PWM1Gen0_Handler(void) DEBIL;
+void Int_PWM1Gen1_Handler(void) DEBIL;
+void Int_PWM1Gen2_Handler(void) DEBIL;
+void Int_PWM1Gen3_Handler(void) DEBIL;
+void Int_PWM1Fault_Handler(void) DEBIL;
+
+//*****************************************************************************
+//
+// The vector table.  Note that the proper constructs must be placed on this to
+// ensure that it ends up at physical address 0x0000.0000 or at the start of
+// the program if located at a start address other than 0.
+//
+//*****************************************************************************
+#pragma DATA_SECTION(g_pfnVectors, ".intvecs")
+void (* const g_pfnVectors[])(void) =
+{
+    (void (*)(void))((uint32_t)&__STACK_TOP),
+                                            // The initial stack pointer
+    ResetISR,                               // The reset handler
+    NmiSR,                                  // The NMI handler
+    FaultISR,                               // The hard fault handler
+    Int_MPUFault_Handler,                   // The MPU fault handler
+    Int_BusFault_Handler,                   // The bus fault handler
+    Int_UsageFault_Handler,                 // The usage fault handler
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_SVCall_Handler,                     // SVCall handler
+    Int_DebugMon_Handler,                   // Debug monitor handler
+    0,                                      // Reserved
+    Int_PendSV_Handler,                     // The PendSV handler
+    Int_SysTick_Handler,                    // The SysTick handler
+    Int_GPIOA_Handler,                      // GPIO Port A
+    Int_GPIOB_Handler,                      // GPIO Port B
+    Int_GPIOC_Handler,                      // GPIO Port C
+    Int_GPIOD_Handler,                      // GPIO Port D
+    Int_GPIOE_Handler,                      // GPIO Port E
+    Int_UART0_Handler,                      // UART0 Rx and Tx
+    Int_UART1_Handler,                      // UART1 Rx and Tx
+    Int_SSI0_Handler,                       // SSI0 Rx and Tx
+    Int_I2C0_Handler,                       // I2C0 Master and Slave
+    Int_PWM0Fault_Handler,                  // PWM Fault
+    Int_PWM0Gen0_Handler,                   // PWM Generator 0
+    Int_PWM0Gen1_Handler,                   // PWM Generator 1
+    Int_PWM0Gen2_Handler,                   // PWM Generator 2
+    Int_QEI0_Handler,                       // Quadrature Encoder 0
+    Int_ADC0SS0_Handler,                    // ADC Sequence 0
+    Int_ADC0SS1_Handler,                    // ADC Sequence 1
+    Int_ADC0SS2_Handler,                    // ADC Sequence 2
+    Int_ADC0SS3_Handler,                    // ADC Sequence 3
+    Int_Watchdog_Handler,                   // Watchdog timer
+    Int_Timer0A_Handler,                    // Timer 0 subtimer A
+    Int_Timer0B_Handler,                    // Timer 0 subtimer B
+    Int_Timer1A_Handler,                    // Timer 1 subtimer A
+    Int_Timer1B_Handler,                    // Timer 1 subtimer B
+    Int_Timer2A_Handler,                    // Timer 2 subtimer A
+    Int_Timer2B_Handler,                    // Timer 2 subtimer B
+    Int_Comp0_Handler,                      // Analog Comparator 0
+    Int_Comp1_Handler,                      // Analog Comparator 1
+    Int_Comp2_Handler,                      // Analog Comparator 2
+    Int_SysCtl_Handler,                     // System Control (PLL, OSC, BO)
+    Int_Flash_Handler,                      // FLASH Control
+    Int_GPIOF_Handler,                      // GPIO Port F
+    Int_GPIOG_Handler,                      // GPIO Port G
+    Int_GPIOH_Handler,                      // GPIO Port H
+    Int_UART2_Handler,                      // UART2 Rx and Tx
+    Int_SSI1_Handler,                       // SSI1 Rx and Tx
+    Int_Timer3A_Handler,                    // Timer 3 subtimer A
+    Int_Timer3B_Handler,                    // Timer 3 subtimer B
+    Int_I2C1_Handler,                       // I2C1 Master and Slave
+    Int_QEI1_Handler,                       // Quadrature Encoder 1
+    Int_CAN0_Handler,                       // CAN0
+    Int_CAN1_Handler,                       // CAN1
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_Hibernate_Handler,                  // Hibernate
+    Int_USB0_Handler,                       // USB0
+    Int_PWM0Gen3_Handler,                   // PWM Generator 3
+    Int_uDMA_Handler,                       // uDMA Software Transfer
+    Int_uDMAErr_Handler,                    // uDMA Error
+    Int_ADC1SS0_Handler,                    // ADC1 Sequence 0
+    Int_ADC1SS1_Handler,                    // ADC1 Sequence 1
+    Int_ADC1SS2_Handler,                    // ADC1 Sequence 2
+    Int_ADC1SS3_Handler,                    // ADC1 Sequence 3
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_GPIOJ_Handler,                      // GPIO Port J
+    Int_GPIOK_Handler,                      // GPIO Port K
+    Int_GPIOL_Handler,                      // GPIO Port L
+    Int_SSI2_Handler,                       // SSI2 Rx and Tx
+    Int_SSI3_Handler,                       // SSI3 Rx and Tx
+    Int_UART3_Handler,                      // UART3 Rx and Tx
+    Int_UART4_Handler,                      // UART4 Rx and Tx
+    Int_UART5_Handler,                      // UART5 Rx and Tx
+    Int_UART6_Handler,                      // UART6 Rx and Tx
+    Int_UART7_Handler,                      // UART7 Rx and Tx
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_I2C2_Handler,                       // I2C2 Master and Slave
+    Int_I2C3_Handler,                       // I2C3 Master and Slave
+    Int_Timer4A_Handler,                    // Timer 4 subtimer A
+    Int_Timer4B_Handler,                    // Timer 4 subtimer B
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_Timer5A_Handler,                    // Timer 5 subtimer A
+    Int_Timer5B_Handler,                    // Timer 5 subtimer B
+    Int_WTimer0A_Handler,                   // Wide Timer 0 subtimer A
+    Int_WTimer0B_Handler,                   // Wide Timer 0 subtimer B
+    Int_WTimer1A_Handler,                   // Wide Timer 1 subtimer A
+    Int_WTimer1B_Handler,                   // Wide Timer 1 subtimer B
+    Int_WTimer2A_Handler,                   // Wide Timer 2 subtimer A
+    Int_WTimer2B_Handler,                   // Wide Timer 2 subtimer B
+    Int_WTimer3A_Handler,                   // Wide Timer 3 subtimer A
+    Int_WTimer3B_Handler,                   // Wide Timer 3 subtimer B
+    Int_WTimer4A_Handler,                   // Wide Timer 4 subtimer A
+    Int_WTimer4B_Handler,                   // Wide Timer 4 subtimer B
+    Int_WTimer5A_Handler,                   // Wide Timer 5 subtimer A
+    Int_WTimer5B_Handler,                   // Wide Timer 5 subtimer B
+    Int_FPU_Handler,                        // FPU
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_I2C4_Handler,                       // I2C4 Master and Slave
+    Int_I2C5_Handler,                       // I2C5 Master and Slave
+    Int_GPIOM_Handler,                      // GPIO Port M
+    Int_GPION_Handler,                      // GPIO Port N
+    Int_QEI2_Handler,                       // Quadrature Encoder 2
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Int_GPIOP0_Handler,                     // GPIO Port P (Summary or P0)
+    Int_GPIOP1_Handler,                     // GPIO Port P1
+    Int_GPIOP2_Handler,                     // GPIO Port P2
+    Int_GPIOP3_Handler,                     // GPIO Port P3
+    Int_GPIOP4_Handler,                     // GPIO Port P4
+    Int_GPIOP5_Handler,                     // GPIO Port P5
+    Int_GPIOP6_Handler,                     // GPIO Port P6
+    Int_GPIOP7_Handler,                     // GPIO Port P7
+    Int_GPIOQ0_Handler,                     // GPIO Port Q (Summary or Q0)
+    Int_GPIOQ1_Handler,                     // GPIO Port Q1
+    Int_GPIOQ2_Handler,                     // GPIO Port Q2
+    Int_GPIOQ3_Handler,                     // GPIO Port Q3
+    Int_GPIOQ4_Handler,                     // GPIO Port Q4
+    Int_GPIOQ5_Handler,                     // GPIO Port Q5
+    Int_GPIOQ6_Handler,                     // GPIO Port Q6
+    Int_GPIOQ7_Handler,                     // GPIO Port Q7
+    Int_GPIOR_Handler,                      // GPIO Port R
+    Int_GPIOS_Handler,                      // GPIO Port S
+    Int_PWM1Gen0_Handler,                   // PWM 1 Generator 0
+    Int_PWM1Gen1_Handler,                   // PWM 1 Generator 1
+    Int_PWM1Gen2_Handler,                   // PWM 1 Generator 2
+    Int_PWM1Gen3_Handler,                   // PWM 1 Generator 3
+    Int_PWM1Fault_Handler                   // PWM 1 Fault
+};
+
+//*****************************************************************************
+//
+// This is the code that gets called when the processor first starts execution
+// following a reset event.  Only the absolutely necessary set is performed,
+// after which the application supplied entry() routine is called.  Any fancy
+// actions (such as making decisions based on the reset cause register, and
+// resetting the bits in that register) are left solely in the hands of the
+// application.
+//
+//*****************************************************************************
+void
+ResetISR(void)
+{
+    //
+    // Marca de tiempo del reset (arranque.c)
+    //
+    Arranque_Reset();
+
+    //
+    // Jump to the CCS C initialization routine.  This will enable the
+    // floating-point unit as well, so that does not need to be done here.
+    //
+    __asm("    .global _c_int00\n"
+          "    b.w     _c_int00");
+}
+
+//*****************************************************************************
+//
+// This is the code that gets called when the processor receives a NMI.  This
+// simply enters an infinite loop, preserving the system state for examination
+// by a debugger.
+//
+//*****************************************************************************
+static void
+NmiSR(void)
+{
+    //
+    // Enter an infinite loop.
+    //
+    while(1)
+    {
+    }
+}
+
+//*****************************************************************************
+//
+// This is the code that gets called when the processor receives a fault
+// interrupt.  This simply enters an infinite loop, preserving the system state
+// for examination by a debugger.
+//
+//*****************************************************************************
+static void
+FaultISR(void)
+{
+    //
+    // Enter an infinite loop.
+    //
+    while(1)
+    {
+    }
+}
+
+//*****************************************************************************
+//
+// Gancho vacio del reset, arranque.c lo reemplaza
+//
+//*****************************************************************************
+void
+Arranque_Reset(void)
+{
+}
+
+//*****************************************************************************
+//
+// This is the code that gets called when the processor receives an unexpected
+// interrupt.  This simply enters an infinite loop, preserving the system state
+// for examination by a debugger.
+//
+//*****************************************************************************
+void
+IntDefaultHandler(void)
+{
+    //
+    // Go into an infinite loop.
+    //
+    while(1)
+    {
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * vectores.c
+ *
+ * Medicion del despacho con la tabla de vectores de flash y la de SRAM, ver vectores.h
+ */
+
+#include "vectores.h"
+#include "inc/hw_types.h"
+#include "inc/hw_nvic.h"
+#include "driverlib/interrupt.h"
+
+extern void (* const g_pfnVectors[])(void);
+
+volatile uint32_t vectoresEntrada;
+
+/*
+ * Minimo de ciclos del disparo por software a la entrada de la sonda con la tabla activa
+ */
+static uint32_t Vectores_Latencia(uint32_t interrupcion) {
+	uint32_t i, inicio, ciclos, minimo = 0xffffffff;
+
+	for (i = 0; i < VECTORES_MEDICIONES; i++) {
+		vectoresEntrada = 0;
+		inicio = PERFIL_CICLOS();
+		HWREG(NVIC_SW_TRIG) = interrupcion - 16;
+		while (vectoresEntrada == 0) {}
+		ciclos = vectoresEntrada - inicio;
+		if (ciclos < minimo) {
+			minimo = ciclos;
+		}
+	}
+	return minimo;
+}
+
+/*
+ * Mide el despacho de la interrupcion con las dos tablas. La sonda debe estar en la tabla de
+ * flash para ese vector (VECTORES_SONDA con el nombre debil), si no flash queda en 0; en SRAM se
+ * registra con IntRegister y al final se deja el manejador y la tabla que habia. Necesita las
+ * interrupciones habilitadas.
+ */
+void Vectores_Medir(uint32_t interrupcion, t_manejador sonda, t_latenciaVectores *r) {
+	uint32_t tabla = HWREG(NVIC_VTABLE);
+	t_manejador anterior = (t_manejador)HWREG(tabla + 4 * interrupcion);
+	uint32_t tablaRAM;
+
+	// CYCCNT sin reiniciar, como en perfil.c
+	*((volatile uint32_t *)DEMCR) |= 0x01000000;
+	*((volatile uint32_t *)DWT_CTRL) |= 0x00000001;
+
+	// IntRegister deja activa la tabla de SRAM de driverlib
+	IntRegister(interrupcion, sonda);
+	tablaRAM = HWREG(NVIC_VTABLE);
+	IntEnable(interrupcion);
+
+	// Sin la sonda en flash la interrupcion iria a otro manejador y no terminaria la medicion
+	HWREG(NVIC_VTABLE) = (uint32_t)g_pfnVectors;
+	r->flash = (g_pfnVectors[interrupcion] == sonda) ? Vectores_Latencia(interrupcion) : 0;
+	HWREG(NVIC_VTABLE) = tablaRAM;
+	r->ram = Vectores_Latencia(interrupcion);
+
+	IntDisable(interrupcion);
+	IntRegister(interrupcion, anterior);
+	HWREG(NVIC_VTABLE) = tabla;
+}
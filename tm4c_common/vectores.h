@@ -0,0 +1,43 @@
+/*
+ * vectores.h
+ *
+ * Medicion del despacho de interrupciones con la tabla de vectores de flash y la de SRAM.
+ * Los manejadores se cambian en ejecucion con IntRegister/IntUnregister de driverlib: el primer
+ * registro copia la tabla activa a g_pfnRAMVectors (seccion .vtable en 0x20000000, reservada en el
+ * archivo de enlace) y mueve NVIC_VTABLE a la copia. Los manejadores que no se registran siguen
+ * siendo los de la tabla de flash (alias debiles del archivo de arranque).
+ *
+ * Medicion del despacho: VECTORES_SONDA(nombre) define un manejador que solo guarda el CYCCNT
+ * al entrar. Vectores_Medir dispara la interrupcion por software (NVIC_SW_TRIG) con la tabla de
+ * flash y con la de SRAM y guarda el minimo de ciclos hasta la primera instruccion del manejador.
+ * Para la tabla de flash la sonda tiene que tener el nombre debil del vector, por ejemplo
+ * VECTORES_SONDA(Int_Comp2_Handler) con INT_COMP2, que no usa ningun proyecto.
+ */
+
+#ifndef VECTORES_H_
+#define VECTORES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "perfil.h"
+
+#define VECTORES_MEDICIONES	16
+
+typedef void (*t_manejador)(void);
+
+struct latenciaVectores {
+	uint32_t flash;			// ciclos minimos del disparo a la entrada con la tabla de flash
+	uint32_t ram;			// lo mismo con la tabla en SRAM
+};
+
+typedef struct latenciaVectores t_latenciaVectores;
+
+extern volatile uint32_t vectoresEntrada;
+
+// Manejador de prueba para Vectores_Medir
+#define VECTORES_SONDA(nombre)	\
+	void nombre(void) { vectoresEntrada = PERFIL_CICLOS(); }
+
+void Vectores_Medir(uint32_t interrupcion, t_manejador sonda, t_latenciaVectores *r);
+
+#endif /* VECTORES_H_ */
@@ -20,6 +20,8 @@
 #include "driverlib/adc.h"
 #include "driverlib/interrupt.h"
 //#include "driverlib/debug.h"
+#include "pin_gpio.h"
+#include "reposo.h"
 
 // Prototipos de funciones
 void ADC0SS3_Init(void);
@@ -27,7 +29,10 @@ void Timer0_Init(uint32_t ciclos);
 void configurarLEDs(void);
 
 // Definiciones
-#define PF2	HWREG(GPIO_PORTF_BASE + 16)
+DEFINIR_PIN(PF2, GPIO_PUERTO_F, GPIO_PIN_2)
+
+// Variables globales
+t_estadisticasReposo reposo;		// residencia en sleep
 
 int main(void) {
 	// Configurar el reloj a 40MHz
@@ -39,11 +44,19 @@ int main(void) {
 	ADC0SS3_Init();
 	// Configurar el timer a 1s@40MHz
 	Timer0_Init(40000000);
+	// Perifericos que siguen con reloj mientras el nucleo duerme
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOF);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOB);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_ADC0);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_TIMER0);
+	Reposo_Init(TIMER0_BASE);
 	// Configurar interrupciones globales
 	IntMasterEnable();
 
 	while (1) {
-		// Esperar las interrupciones
+		// Dormir hasta las interrupciones
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
 	}
 }
 
@@ -93,14 +106,15 @@ void Timer0_Init(uint32_t ciclos) {
  */
 void configurarLEDs(void) {
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2);
-	PF2 = 0xff;
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_2);
+	PF2_Alto();
 }
 
 /*
  * Rutina de interrupcion ADC0SS3
  */
-void Int_ADC0SS3(void) {
+void Int_ADC0SS3_Handler(void) {
 	volatile uint16_t muestra;
 
 	// Borrar la interrupcion
@@ -113,5 +127,5 @@ void Int_ADC0SS3(void) {
 	// Operaciones sobre la muestra
 
 	// Hacer toggle a PF2
-	PF2 ^= 0xff;
+	PF2_Conmutar();
 }
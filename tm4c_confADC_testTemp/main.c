@@ -6,66 +6,153 @@
  * para muestrear de forma periodica una seal del sensor de temperatura
  *
  * Todo utilizando la libreria Tivaware
+ *
+ * Con __PERFIL__ las rutinas de interrupcion se miden con sondas del contador de ciclos (DWT);
+ * por UART0 a 115200 el comando 'p' envia la tabla de ciclos y 'r' la reinicia.
+ *
+ * Escalado de frecuencia (escalado.c): el muestreo corre a 16MHz con el PLL apagado y el ADC con
+ * el reloj del PIOSC. Cada BLOQUE muestras el programa sube a 80MHz (RELOJ_RAFAGA), calcula la
+ * temperatura promedio, minima y maxima del bloque y vuelve a 16MHz. CambioReloj recalcula la
+ * carga de Timer0 y el divisor de UART0 en cada cambio.
+ *
+ * Tiempos de arranque (arranque.c): ResetISR, .cinit, reloj, perifericos y primera muestra
+ * quedan en arranque.us. Con __ARRANQUE_RAPIDO__ la primera muestra se toma por software con
+ * el PIOSC del reset, antes del PLL y del resto de perifericos, y los bloques no se borran.
+ *
+ * El calculo de temperaturas corre desde SRAM (EN_RAM, codigo_ram.c). Con __BENCHMARK_RAM__ se
+ * miden los ciclos de Temperaturas a 80MHz desde la copia en flash y desde SRAM (ciclosFlash,
+ * ciclosRAM). Las rutinas de interrupcion se quedan en flash: solo se mueven a SRAM si sus sondas
+ * (isrADC, isrTimer0) muestran que ganan ciclos.
  */
 
+// Descomentar para comparar los ciclos del calculo de temperaturas desde flash y desde SRAM
+//#define __BENCHMARK_RAM__
+
+// Descomentar para tomar la primera muestra antes de configurar el reloj y los demas perifericos
+//#define __ARRANQUE_RAPIDO__
+
+// Descomentar para medir los ciclos de las rutinas de interrupcion
+//#define __PERFIL__
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
+#include "inc/hw_timer.h"
 #include "inc/tm4c123gh6pm.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
 #include "driverlib/timer.h"
 #include "driverlib/adc.h"
 #include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/uart.h"
+#include "pin_gpio.h"
+#include "reposo.h"
+#include "perfil.h"
+#include "reloj.h"
+#include "escalado.h"
+#include "divisor.h"
+#include "arranque.h"
+#include "codigo_ram.h"
 
 // definiciones
-#define PF3		HWREG(GPIO_PORTF_BASE + 0x20)
-#define PF2		HWREG(GPIO_PORTF_BASE + 0x10)
+DEFINIR_PIN(PF3, GPIO_PUERTO_F, GPIO_PIN_3)
+DEFINIR_PIN(PF2, GPIO_PUERTO_F, GPIO_PIN_2)
 // control para configurar si se desean las interrupciones del timer, comentar si no se desean
 #define __WithTimerInterrupts__
+// muestras por bloque procesado en el perfil rapido
+#define BLOQUE	8
+// periodo de muestreo en ciclos para el reloj dado (0.5s)
+#define CARGA_MUESTREO(reloj)	((reloj) / 2)
+#define BENCH_MUESTRAS	256
+
+// Temperaturas de un bloque en decimas de grado
+struct temperaturas {
+	int32_t promedio;
+	int32_t minima;
+	int32_t maxima;
+};
+
+typedef struct temperaturas t_temperaturas;
+typedef void (*t_kernelTemperaturas)(const uint16_t *muestras, uint32_t n, t_temperaturas *r);
 
 // variables globales
 unsigned long valorSensor = 0, noConversiones = 0;
+t_estadisticasReposo reposo;		// residencia en sleep
+volatile bool volcarPerfil = false;	// comando 'p' recibido por UART0
+
+// bloques de muestras, el ADC llena uno mientras el programa procesa el otro
+#if defined(__ARRANQUE_RAPIDO__) && defined(__TI_COMPILER_VERSION__)
+#pragma NOINIT(bloques)		// se procesan solo despues de llenarlos, no hace falta borrarlos
+#endif
+uint16_t bloques[2][BLOQUE];
+uint32_t indiceMuestra = 0, bloqueLlenando = 0;
+volatile int32_t bloqueListo = -1;	// bloque por procesar, -1 si no hay
+// resultado del ultimo bloque
+t_temperaturas temperatura;
+uint32_t bloquesProcesados = 0, fallosPLL = 0;
+t_avisoReloj avisoMuestreo;
+
+#ifdef __BENCHMARK_RAM__
+// Resultados del benchmark, para revisarlos con el debugger
+uint16_t benchMuestras[BENCH_MUESTRAS];
+uint32_t ciclosFlash = 0, ciclosRAM = 0;
+#endif
+
+// sondas de perfilado
+PERFIL_SONDA(isrADC);
+PERFIL_SONDA(isrTimer0);
+
+// Prototipos de funciones
+void ConfigurarADC(void);
+void PrimeraMuestra(void);
+void ConfigurarUART(void);
+void UART_Enviar(uint8_t dato);
+void CambioReloj(uint32_t anterior, uint32_t nuevo);
+void ProcesarBloque(const uint16_t *muestras);
+void Temperaturas(const uint16_t *muestras, uint32_t n, t_temperaturas *r);
+void BenchmarkRAM(void);
 
 
 /*
  * Programa principal
  */
 int main(void) {
-	// Configurar el reloj principal a 40MHz con PLL
-	SysCtlClockSet(SYSCTL_SYSDIV_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
-	// 1.1 Configuracion de frecuencia de muestreo
-	SysCtlADCSpeedSet(SYSCTL_ADCSPEED_125KSPS);
+	Arranque_Marcar(ARRANQUE_MAIN);
+	// Copiar las funciones EN_RAM antes de usarlas
+	CodigoRAM_Init();
+#ifdef __ARRANQUE_RAPIDO__
+	// PRIMASK sale del reset en 0: sin esto Int_ADC0SS3_Handler toma la primera conversion y
+	// borra la bandera que espera PrimeraMuestra. IntMasterEnable las vuelve a habilitar.
+	IntMasterDisable();
+	// El ADC usa el PIOSC, no necesita el PLL para la primera muestra
+	ConfigurarADC();
+	PrimeraMuestra();
+#endif
+
+	// Configurar el reloj principal a 80MHz con PLL, se baja a 16MHz antes de muestrear
+	Reloj_Init();
+	Arranque_Marcar(ARRANQUE_RELOJ);
 
 	// Configuracion de un led para toggle
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_2|GPIO_PIN_3);
-	PF2 = 0;
-	PF3 = 0;
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_2|GPIO_PIN_3);
+	PF2_Bajo();
+	PF3_Bajo();
 
-	// Configuracion del modulo ADC0
-	// 1. Configuracion de reloj al periferico
-	SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-
-	// 2. Configurar el numero de secuenciador (=3) y el trigger
-	ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_TIMER, 0);
-	// 3. Configurar el unico paso del secuenciador 3 para sensar temperatura y generar interrupcion
-	ADCSequenceStepConfigure(ADC0_BASE, 3, 0, ADC_CTL_TS | ADC_CTL_IE | ADC_CTL_END);
-	// 4. Configurar las interrupciones
-	ADCIntEnable(ADC0_BASE, 3);
-	IntEnable(INT_ADC0SS3);
-	IntPrioritySet(INT_ADC0SS3, 2);
-	// 4. Habilitar el secuenciador 3
-	ADCSequenceEnable(ADC0_BASE, 3);
+#ifndef __ARRANQUE_RAPIDO__
+	ConfigurarADC();
+#endif
 
 	// Configuracion del timer para muestreo
 	// 1. Configuracion de reloj al periferico
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
 	// 2. Configurar el timer para modo de 32 bits periodico
 	TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
-	// 3. Configurar el periodo de timeout para 0.5s@40MHz
-	TimerLoadSet(TIMER0_BASE, TIMER_A, 20000000-1);
+	// 3. Configurar el periodo de timeout para 0.5s con el reloj actual
+	TimerLoadSet(TIMER0_BASE, TIMER_A, CARGA_MUESTREO(Reloj_Frecuencia()) - 1);
 	// 4. Configurar trigger para ADC
 	TimerControlTrigger(TIMER0_BASE, TIMER_A, true);
 
@@ -73,29 +160,227 @@ int main(void) {
 	// 5. Configurar las interrupciones
 	TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT); // configuracion en el modulo
 	IntEnable(INT_TIMER0A);							 // configuracion en el NVIC
-	IntPrioritySet(INT_TIMER0A, 2);
+	IntPrioritySet(INT_TIMER0A, 0x40);				 // prioridad 2 (bits 7:5)
 #endif
 	// 6. Iniciar el timer
 	TimerEnable(TIMER0_BASE, TIMER_A);
 
+	// UART0 para los comandos del perfilado y contador de ciclos
+	ConfigurarUART();
+	Perfil_Init();
+
+#ifdef __BENCHMARK_RAM__
+	// Todavia a 80MHz, con los estados de espera de la flash
+	BenchmarkRAM();
+#endif
+
+	// Perifericos que siguen con reloj mientras el nucleo duerme
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOF);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_ADC0);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_TIMER0);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_UART0);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOA);
+	Reposo_Init(TIMER0_BASE);
+
+	// Bajar al perfil lento para el muestreo
+	Escalado_Avisar(&avisoMuestreo, CambioReloj);
+	Escalado_Cambiar(RELOJ_LENTO);
+	Arranque_Marcar(ARRANQUE_PERIFERICOS);
+
 	// Habilitar interrupciones globales
 	IntMasterEnable();
 
 	while (1) {
-		//esperar interrupciones
+		// dormir hasta las interrupciones
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
+		// procesar el bloque completo en el perfil rapido
+		if (bloqueListo >= 0) {
+			if (!Escalado_Cambiar(RELOJ_RAFAGA)) {
+				fallosPLL++;		// se procesa igual a 16MHz
+			}
+			ProcesarBloque(bloques[bloqueListo]);
+			bloqueListo = -1;
+			Escalado_Cambiar(RELOJ_LENTO);
+		}
+		// el volcado se hace fuera de las interrupciones, con UARTCharPut
+		if (volcarPerfil) {
+			volcarPerfil = false;
+			Perfil_Volcar(UART_Enviar);
+		}
+	}
+}
+
+/*
+ * Configura ADC0 con el secuenciador 3 disparado por Timer0
+ */
+void ConfigurarADC(void) {
+	// Configuracion del modulo ADC0
+	// 1. Configuracion de reloj al periferico
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+	// 1.1 Reloj del ADC desde el PIOSC, sigue igual con el PLL apagado
+	ADCClockConfigSet(ADC0_BASE, ADC_CLOCK_SRC_PIOSC | ADC_CLOCK_RATE_EIGHTH, 1);
+
+	// 2. Configurar el numero de secuenciador (=3) y el trigger
+	ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_TIMER, 0);
+	// 3. Configurar el unico paso del secuenciador 3 para sensar temperatura y generar interrupcion
+	ADCSequenceStepConfigure(ADC0_BASE, 3, 0, ADC_CTL_TS | ADC_CTL_IE | ADC_CTL_END);
+	// 4. Configurar las interrupciones
+	ADCIntEnable(ADC0_BASE, 3);
+	IntEnable(INT_ADC0SS3);
+	IntPrioritySet(INT_ADC0SS3, 0x40);	// prioridad 2 (bits 7:5)
+	// 4. Habilitar el secuenciador 3
+	ADCSequenceEnable(ADC0_BASE, 3);
+}
+
+/*
+ * Arranque rapido: una conversion por software esperando la bandera, con las interrupciones
+ * globales deshabilitadas por main, luego el secuenciador vuelve al disparo de Timer0
+ */
+void PrimeraMuestra(void) {
+	ADCSequenceDisable(ADC0_BASE, 3);
+	ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
+	ADCSequenceEnable(ADC0_BASE, 3);
+
+	ADCProcessorTrigger(ADC0_BASE, 3);
+	while (!ADCIntStatus(ADC0_BASE, 3, false)) {}
+	valorSensor = (ADC0_SSFIFO3_R & 0x00000fff);
+	noConversiones++;
+	Arranque_Marcar(ARRANQUE_PRIMERA);
+
+	// Borrar la bandera y la interrupcion pendiente en el NVIC para que no se lea dos veces
+	ADCIntClear(ADC0_BASE, 3);
+	IntPendClear(INT_ADC0SS3);
+
+	ADCSequenceDisable(ADC0_BASE, 3);
+	ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_TIMER, 0);
+	ADCSequenceEnable(ADC0_BASE, 3);
+}
+
+/*
+ * Configura UART0 a 115200 con interrupcion de recepcion para los comandos
+ */
+void ConfigurarUART(void) {
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+	GPIOPinConfigure(GPIO_PA0_U0RX);
+	GPIOPinConfigure(GPIO_PA1_U0TX);
+	GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+	Divisor_UART(UART0_BASE, UART_DIVISOR(Reloj_Frecuencia(), 115200), UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+	UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+	IntEnable(INT_UART0);
+	IntPrioritySet(INT_UART0, 0x60);	// prioridad 3, debajo del ADC y el Timer: el eco espera
+}
+
+void UART_Enviar(uint8_t dato) {
+	UARTCharPut(UART0_BASE, dato);
+}
+
+/*
+ * Aviso de cambio de reloj (interrupciones deshabilitadas): recalcula el periodo de muestreo
+ * conservando la fraccion que faltaba del periodo actual y el divisor de UART0
+ */
+void CambioReloj(uint32_t anterior, uint32_t nuevo) {
+	uint32_t restante = TimerValueGet(TIMER0_BASE, TIMER_A);
+
+	TimerLoadSet(TIMER0_BASE, TIMER_A, CARGA_MUESTREO(nuevo) - 1);
+	HWREG(TIMER0_BASE + TIMER_O_TAV) = (uint32_t)(((uint64_t)restante * nuevo) / anterior);
+	Reposo_CambiarCarga();
+
+	// Divisor_UART espera a que salga el ultimo caracter antes de cambiar el divisor
+	Divisor_UART(UART0_BASE, UART_DIVISOR(nuevo, 115200), UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+}
+
+void ProcesarBloque(const uint16_t *muestras) {
+	Temperaturas(muestras, BLOQUE, &temperatura);
+	bloquesProcesados++;
+}
+
+/*
+ * Temperatura en decimas de grado: TEMP = 147.5 - (75 * 3.3 * ADC) / 4096
+ * Funcion hoja en SRAM, CodigoRAM_Flash puede llamar su copia en flash.
+ */
+EN_RAM void Temperaturas(const uint16_t *muestras, uint32_t n, t_temperaturas *r) {
+	int32_t t, suma = 0, minima = 0x7fffffff, maxima = -0x7fffffff;
+	uint32_t i;
+
+	for (i = 0; i < n; i++) {
+		t = 1475 - (2475 * (int32_t)muestras[i]) / 4096;
+		suma += t;
+		if (t < minima) {
+			minima = t;
+		}
+		if (t > maxima) {
+			maxima = t;
+		}
+	}
+	r->promedio = suma / (int32_t)n;
+	r->minima = minima;
+	r->maxima = maxima;
+}
+
+#ifdef __BENCHMARK_RAM__
+/*
+ * Minimo de ciclos de Temperaturas sobre BENCH_MUESTRAS desde flash y desde SRAM
+ */
+void BenchmarkRAM(void) {
+	t_kernelTemperaturas enFlash = (t_kernelTemperaturas)CodigoRAM_Flash((uint32_t)Temperaturas);
+	t_temperaturas r;
+	uint32_t i, inicio, ciclos;
+
+	for (i = 0; i < BENCH_MUESTRAS; i++) {
+		benchMuestras[i] = (i * 37) & 0x0fff;
+	}
+
+	ciclosFlash = 0xffffffff;
+	ciclosRAM = 0xffffffff;
+	for (i = 0; i < 8; i++) {
+		inicio = PERFIL_CICLOS();
+		enFlash(benchMuestras, BENCH_MUESTRAS, &r);
+		ciclos = PERFIL_CICLOS() - inicio;
+		if (ciclos < ciclosFlash) {
+			ciclosFlash = ciclos;
+		}
+
+		inicio = PERFIL_CICLOS();
+		Temperaturas(benchMuestras, BENCH_MUESTRAS, &r);
+		ciclos = PERFIL_CICLOS() - inicio;
+		if (ciclos < ciclosRAM) {
+			ciclosRAM = ciclos;
+		}
+	}
+}
+#endif
+
+/*
+ * Manejador de interrupcion de UART0: 'p' pide el volcado del perfil, 'r' reinicia las sondas
+ */
+void Int_UART0_Handler(void) {
+	int32_t c;
+
+	UARTIntClear(UART0_BASE, UARTIntStatus(UART0_BASE, true));
+	while (UARTCharsAvail(UART0_BASE)) {
+		c = UARTCharGetNonBlocking(UART0_BASE);
+		if (c == 'p') {
+			volcarPerfil = true;
+		} else if (c == 'r') {
+			Perfil_Reiniciar();
+		}
 	}
 }
 
 /*
  * Manejador de interrupcion de timeout de Timer0 en modo de  32bits
  */
-void Timer0_TimeoutHandler(void) {
+void Int_Timer0A_Handler(void) {
 #ifdef __WithTimerInterrupts__
+	PERFIL_INICIO(isrTimer0);
 	// Borrar la bandera de interrupcion
 	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
 
 	// Hacer toggle al led
-	PF3 ^= 0xff;
+	PF3_Conmutar();
+	PERFIL_FIN(isrTimer0);
 #else
 	while(1) {
 		// como FaultISR
@@ -108,7 +393,8 @@ void Timer0_TimeoutHandler(void) {
 /*
  * Manejador de interrupcion de conversion completa
  */
-void ADC0SS3_Handler(void) {
+void Int_ADC0SS3_Handler(void) {
+	PERFIL_INICIO(isrADC);
 	// Borrar la interrupcion
 	ADCIntClear(ADC0_BASE, 3);
 
@@ -116,8 +402,19 @@ void ADC0SS3_Handler(void) {
 	valorSensor = (ADC0_SSFIFO3_R & 0x00000fff);
 #ifndef __WithTimerInterrupts__
 	// Hacer toggle al led
-	PF2 ^= 0xff;
+	PF2_Conmutar();
 #endif
+	if (noConversiones == 0) {
+		Arranque_Marcar(ARRANQUE_PRIMERA);
+	}
+	// guardar en el bloque y cambiar de bloque al llenarlo
+	bloques[bloqueLlenando][indiceMuestra++] = valorSensor;
+	if (indiceMuestra == BLOQUE) {
+		bloqueListo = bloqueLlenando;
+		bloqueLlenando ^= 1;
+		indiceMuestra = 0;
+	}
 	// aumentar el contador
 	noConversiones++;
+	PERFIL_FIN(isrADC);
 }
@@ -35,9 +35,14 @@ SECTIONS
     .pinit  :   > FLASH
     .init_array : > FLASH
 
+    /* Funciones EN_RAM (codigo_ram.h): se cargan en flash y corren en SRAM */
+    .ramfunc :  LOAD = FLASH, RUN = SRAM,
+                LOAD_START(codigoRAMCarga), RUN_START(codigoRAMInicio), SIZE(codigoRAMTamano)
+
     .vtable :   > 0x20000000
     .data   :   > SRAM
     .bss    :   > SRAM
+    .TI.noinit : > SRAM
     .sysmem :   > SRAM
     .stack  :   > SRAM
 }
@@ -15,16 +15,25 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
 #include "driverlib/interrupt.h"
+#include "pin_gpio.h"
+#include "reposo.h"
+#include "tiempo.h"
+// Reloj de SysCtlClockSet (PLL / SYSCTL_SYSDIV_5 = 40MHz), RELOJ_SISTEMA de reloj.h coincide
+#define RELOJ_OBJETIVO	40000000
+#include "reloj.h"
 
 
 // definicion de registros
-#define PF3		HWREG(GPIO_PORTF_BASE + 0x20)
-#define PF1		HWREG(GPIO_PORTF_BASE + 0x08)
+DEFINIR_PIN(PF3, GPIO_PUERTO_F, GPIO_PIN_3)
+DEFINIR_PIN(PF1, GPIO_PUERTO_F, GPIO_PIN_1)
 
 // variables globales
 unsigned long noInterrupciones = 0;		// solamente para debugging
 unsigned long noConversiones = 0;
 unsigned long tempSensor = 0;
+uint64_t tiempoConversion = 0;			// marca de tiempo de la ultima conversion en ciclos
+uint32_t periodoConversionUs = 0;		// tiempo entre las dos ultimas conversiones
+t_estadisticasReposo reposo;			// residencia en sleep
 
 /*
  * Configura el modulo ADC0, secuenciador 3 para muestrear temperatura, trigger por timer
@@ -140,20 +149,32 @@ int main(void) {
 
 	// configurar un led
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3);
-	GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3, 0x04);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3);
+	GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3, 0x04);
+
+	// leer el arbol de relojes una vez, base de tiempo para marcar las conversiones
+	Reloj_Leer();
+	Tiempo_Init(relojes.sistema);
 
 	// configurar el adc0ss3
 	ADC0SS3_TimerTrigger_Init();
 	// configurar el timer con el tiempo de muestreo
 	Timer0_Init(20000000);
+	// perifericos que siguen con reloj mientras el nucleo duerme (gating en modo sleep)
+	SYSCTL_SCGCGPIO_R |= SYSCTL_SCGCGPIO_S5;
+	SYSCTL_SCGCADC_R |= SYSCTL_SCGCADC_S0;
+	SYSCTL_SCGCTIMER_R |= SYSCTL_SCGCTIMER_S0;
+	Reposo_Init(TIMER0_BASE);
 	// habilitar las interrupciones globales
 	IntMasterEnable();
 
 	while (1) {
-		// hacer algo, esperar interrupciones
+		// dormir hasta las interrupciones
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
 		/*
-		PF1 ^= 0xff;
+		PF1_Conmutar();
 		SysCtlDelay(10000000);
 		*/
 	}
@@ -162,12 +183,12 @@ int main(void) {
 /*
  * Maneja la interrupcion causada por el timeout del timer0 A
  */
-void Timer0IntHandler(void) {
+void Int_Timer0A_Handler(void) {
 	// Borrar la bandera poniendo a 1 TATOCINT en GPMTICR
 	TIMER0_ICR_R = 0x01;
 
 	// hacer toggle a un led
-	PF3 ^= 0x08;
+	PF3_Conmutar();
 
 	// aumentar el numero de interrupciones
 	noInterrupciones++;
@@ -176,12 +197,20 @@ void Timer0IntHandler(void) {
 /*
  * Maneja la interrupcion causada por el ss3 del adc0
  */
-void ADCSS3_IntHandler(void) {
+void Int_ADC0SS3_Handler(void) {
+	uint64_t ahora = Tiempo_Ciclos();
+
 	// Borrar la bandera IN3 del ADC0_ISC_R escribiendo un 1
 	ADC0_ISC_R |= 0x8;
 
 	// Leer el valor convertido de la memoria
 	tempSensor = ADC0_SSFIFO3_R & 0x00000fff;
 
+	// periodo real de muestreo con la base de tiempo
+	if (noConversiones > 0) {
+		periodoConversionUs = (uint32_t)Tiempo_CiclosAUs(ahora - tiempoConversion);
+	}
+	tiempoConversion = ahora;
+
 	noConversiones++;
 }
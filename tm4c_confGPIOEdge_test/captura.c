@@ -0,0 +1,156 @@
+/*
+ * captura.c
+ *
+ * Conteo y marcas de tiempo de flancos con el Timer2A, ver captura.h
+ */
+
+#include "captura.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/tm4c123gh6pm.h"
+#include "driverlib/interrupt.h"
+#include "pin_gpio.h"
+
+#define CUENTA_MAX		0x00ffffff		// 16 bits del timer + 8 bits del prescaler
+
+static t_modoCaptura modoActual;
+static volatile uint32_t vueltas = 0;		// veces que la cuenta llego a 0 (modo conteo)
+static volatile uint32_t flancos = 0;		// flancos capturados (modo tiempo)
+static volatile uint32_t perdidos = 0;		// periodos descartados con el buffer lleno
+static uint32_t marcaAnterior;
+static bool primerFlanco;
+
+// Buffer circular de periodos: la interrupcion escribe en cabeza, Captura_LeerPeriodos lee en cola
+static volatile uint32_t periodosBuffer[CAPTURA_BUFFER];
+static volatile uint32_t cabeza = 0;
+static volatile uint32_t cola = 0;
+
+/*
+ * Configura PF4 como T2CCP0 y el Timer2A como contador de flancos o captura de tiempo en flanco de bajada
+ */
+void Captura_Init(t_modoCaptura modo) {
+	volatile unsigned long delay;
+
+	modoActual = modo;
+	vueltas = 0;
+	flancos = 0;
+	perdidos = 0;
+	cabeza = 0;
+	cola = 0;
+	primerFlanco = true;
+
+	// Reloj del timer y del puerto F
+	SYSCTL_RCGCTIMER_R |= SYSCTL_RCGCTIMER_R2;
+	SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R5;
+	delay = SYSCTL_RCGCGPIO_R;
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
+
+	// PF4 como entrada de captura con pull-up (boton de la Launchpad)
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_DIR) &= ~0x10;
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_AFSEL) |= 0x10;
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_PCTL) = (GPIO_REG(GPIO_PUERTO_F, GPIO_O_PCTL) & ~GPIO_PCTL_PF4_M) | GPIO_PCTL_PF4_T2CCP0;
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_AMSEL) &= ~0x10;
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_PUR) |= 0x10;
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_DEN) |= 0x10;
+
+	// Timer de 16 bits con el prescaler como extension a 24 bits, cuenta descendente
+	TIMER2_CTL_R &= ~TIMER_CTL_TAEN;
+	TIMER2_CFG_R = TIMER_CFG_16_BIT;
+	if (modo == CAPTURA_CONTEO) {
+		// Conteo de flancos: al llegar a la cuenta de match (0) el timer se recarga y se detiene
+		TIMER2_TAMR_R = TIMER_TAMR_TAMR_CAP;
+		TIMER2_TAMATCHR_R = 0;
+		TIMER2_TAPMR_R = 0;
+		TIMER2_IMR_R = TIMER_IMR_CAMIM;
+	} else {
+		// Captura de tiempo: el contador corre libre y se guarda su valor en cada flanco
+		TIMER2_TAMR_R = TIMER_TAMR_TAMR_CAP | TIMER_TAMR_TACMR;
+		TIMER2_IMR_R = TIMER_IMR_CAEIM;
+	}
+	TIMER2_TAILR_R = CUENTA_MAX & 0xffff;
+	TIMER2_TAPR_R = CUENTA_MAX >> 16;
+	TIMER2_CTL_R = (TIMER2_CTL_R & ~TIMER_CTL_TAEVENT_M) | TIMER_CTL_TAEVENT_NEG;
+	TIMER2_ICR_R = TIMER_ICR_CAMCINT | TIMER_ICR_CAECINT;
+
+	// Interrupcion 23 con prioridad 2: en modo tiempo se atiende una vez por flanco
+	NVIC_PRI5_R = (NVIC_PRI5_R & 0x00FFFFFF) | 0x40000000;
+	NVIC_EN0_R = 1 << 23;
+
+	TIMER2_CTL_R |= TIMER_CTL_TAEN;
+}
+
+/*
+ * Flancos de bajada desde Captura_Init
+ */
+uint32_t Captura_Flancos(void) {
+	uint32_t cuenta, v;
+
+	if (modoActual == CAPTURA_TIEMPO) {
+		return flancos;
+	}
+
+	// Leer la cuenta y las vueltas juntas: si la cuenta llego a 0 y la interrupcion esta pendiente,
+	// el timer ya se recargo y esa vuelta todavia no se sumo
+	IntMasterDisable();
+	cuenta = TIMER2_TAR_R & CUENTA_MAX;
+	v = vueltas;
+	if (TIMER2_MIS_R & TIMER_MIS_CAMMIS) {
+		cuenta = TIMER2_TAR_R & CUENTA_MAX;
+		v += 1;
+	}
+	IntMasterEnable();
+
+	return v * CUENTA_MAX + (CUENTA_MAX - cuenta);
+}
+
+/*
+ * Copia hasta max periodos (en ciclos del reloj del sistema) del buffer y devuelve cuantos copio
+ */
+uint32_t Captura_LeerPeriodos(uint32_t *periodos, uint32_t max) {
+	uint32_t n = 0;
+
+	while (cola != cabeza && n < max) {
+		periodos[n++] = periodosBuffer[cola];
+		cola = (cola + 1) & (CAPTURA_BUFFER - 1);
+	}
+	return n;
+}
+
+/*
+ * Periodos descartados porque el buffer estaba lleno
+ */
+uint32_t Captura_Perdidos(void) {
+	return perdidos;
+}
+
+/*
+ * Rutina de interrupcion del Timer2A
+ */
+void Int_Timer2A_Handler(void) {
+	uint32_t marca, siguiente;
+
+	if (TIMER2_MIS_R & TIMER_MIS_CAMMIS) {
+		// Modo conteo: la cuenta llego a 0, sumar la vuelta y volver a habilitar el timer
+		TIMER2_ICR_R = TIMER_ICR_CAMCINT;
+		vueltas += 1;
+		TIMER2_CTL_R |= TIMER_CTL_TAEN;
+	}
+
+	if (TIMER2_MIS_R & TIMER_MIS_CAEMIS) {
+		// Modo tiempo: periodo desde el flanco anterior, el contador es descendente
+		TIMER2_ICR_R = TIMER_ICR_CAECINT;
+		marca = TIMER2_TAR_R & CUENTA_MAX;
+		flancos += 1;
+		if (!primerFlanco) {
+			siguiente = (cabeza + 1) & (CAPTURA_BUFFER - 1);
+			if (siguiente != cola) {
+				periodosBuffer[cabeza] = (marcaAnterior - marca) & CUENTA_MAX;
+				cabeza = siguiente;
+			} else {
+				perdidos += 1;
+			}
+		}
+		primerFlanco = false;
+		marcaAnterior = marca;
+	}
+}
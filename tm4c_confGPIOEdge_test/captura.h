@@ -0,0 +1,37 @@
+/*
+ * captura.h
+ *
+ * Conteo y marcas de tiempo de flancos en hardware con el Timer2A (T2CCP0 en PF4), sin una
+ * interrupcion del GPIO por flanco:
+ *  - CAPTURA_CONTEO: el timer cuenta los flancos de bajada (24 bits con el prescaler), solo
+ *    interrumpe una vez cada 2^24 flancos para acumular la cuenta.
+ *  - CAPTURA_TIEMPO: el timer guarda el valor del contador en cada flanco de bajada; la
+ *    interrupcion solo calcula el periodo y lo guarda en un buffer que se lee en bloques.
+ *    El periodo maximo es 2^24 ciclos del reloj del sistema (0.42s a 40MHz).
+ *
+ * Los flancos no tienen antirrebote: la entrada es una senal externa en PF4.
+ */
+
+#ifndef CAPTURA_H_
+#define CAPTURA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tamano del buffer de periodos, potencia de 2
+#define CAPTURA_BUFFER	64
+
+enum modoCaptura {
+	CAPTURA_CONTEO,
+	CAPTURA_TIEMPO
+};
+
+typedef enum modoCaptura t_modoCaptura;
+
+void Captura_Init(t_modoCaptura modo);
+uint32_t Captura_Flancos(void);
+uint32_t Captura_LeerPeriodos(uint32_t *periodos, uint32_t max);
+uint32_t Captura_Perdidos(void);
+void Int_Timer2A_Handler(void);
+
+#endif /* CAPTURA_H_ */
@@ -0,0 +1,129 @@
+/*
+ * frecuencimetro.c
+ *
+ * Frecuencimetro reciproco con el Wide Timer 0, ver frecuencimetro.h
+ */
+
+#include "frecuencimetro.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/tm4c123gh6pm.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/interrupt.h"
+
+// Muestra del conteo y del tiempo de un flanco
+struct muestraFrec {
+	uint32_t flancos;
+	uint32_t tiempo;
+	bool enFlanco;		// tiempo capturado en el flanco numero "flancos"
+};
+
+typedef struct muestraFrec t_muestraFrec;
+
+static uint32_t reloj;
+
+/*
+ * Configura PC4 y PC5 como WT0CCP0/WT0CCP1, WTimer0A en captura de tiempo y WTimer0B en conteo
+ * de flancos, ambos de 32 bits ascendentes y en flanco de bajada
+ */
+void Frecuencimetro_Init(uint32_t relojSistema) {
+	volatile unsigned long delay;
+
+	reloj = relojSistema;
+
+	SYSCTL_RCGCWTIMER_R |= SYSCTL_RCGCWTIMER_R0;
+	SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_R2;
+	delay = SYSCTL_RCGCGPIO_R;
+
+	// Solo PC4 y PC5, PC0-3 son el JTAG
+	GPIO_PORTC_DIR_R &= ~0x30;
+	GPIO_PORTC_AFSEL_R |= 0x30;
+	GPIO_PORTC_PCTL_R = (GPIO_PORTC_PCTL_R & ~(GPIO_PCTL_PC4_M | GPIO_PCTL_PC5_M)) |
+			GPIO_PCTL_PC4_WT0CCP0 | GPIO_PCTL_PC5_WT0CCP1;
+	GPIO_PORTC_AMSEL_R &= ~0x30;
+	GPIO_PORTC_DEN_R |= 0x30;
+
+	WTIMER0_CTL_R &= ~(TIMER_CTL_TAEN | TIMER_CTL_TBEN);
+	WTIMER0_CFG_R = TIMER_CFG_16_BIT;		// dos timers de 32 bits
+	WTIMER0_TAMR_R = TIMER_TAMR_TAMR_CAP | TIMER_TAMR_TACMR | TIMER_TAMR_TACDIR;
+	WTIMER0_TBMR_R = TIMER_TBMR_TBMR_CAP | TIMER_TBMR_TBCDIR;
+	WTIMER0_TAILR_R = 0xffffffff;
+	WTIMER0_TBILR_R = 0xffffffff;
+	WTIMER0_TBMATCHR_R = 0xffffffff;
+	WTIMER0_CTL_R = (WTIMER0_CTL_R & ~(TIMER_CTL_TAEVENT_M | TIMER_CTL_TBEVENT_M)) |
+			TIMER_CTL_TAEVENT_NEG | TIMER_CTL_TBEVENT_NEG;
+	WTIMER0_IMR_R = 0;
+
+	WTIMER0_CTL_R |= TIMER_CTL_TAEN | TIMER_CTL_TBEN;
+}
+
+/*
+ * Lee el conteo y el tiempo del ultimo flanco. Si llega un flanco entre las lecturas se repite;
+ * si la senal es demasiado rapida se usa el tiempo actual del contador.
+ */
+static void Frecuencimetro_Muestra(t_muestraFrec *m) {
+	uint32_t t1, t2, c, i;
+
+	IntMasterDisable();
+	for (i = 0; i < FREC_INTENTOS; i++) {
+		t1 = WTIMER0_TAR_R;
+		c = WTIMER0_TBR_R;
+		t2 = WTIMER0_TAR_R;
+		if (t1 == t2) {
+			break;
+		}
+	}
+	if (t1 == t2 && c != 0) {
+		m->tiempo = t1;
+		m->enFlanco = true;
+	} else {
+		m->tiempo = WTIMER0_TAV_R;
+		c = WTIMER0_TBR_R;
+		m->enFlanco = false;
+	}
+	m->flancos = c;
+	IntMasterEnable();
+}
+
+/*
+ * Mide la frecuencia con una compuerta de "compuerta" ciclos del reloj del sistema. Si no llega
+ * ningun flanco la compuerta se extiende hasta FREC_ESPERA_MAX veces; devuelve false si no hubo flancos.
+ */
+bool Frecuencimetro_Medir(uint32_t compuerta, t_medicionFrec *m) {
+	t_muestraFrec inicio, fin;
+	uint32_t espera = 0;
+	uint64_t producto;
+
+	// Reiniciar el conteo antes de que llegue al valor de match
+	if (WTIMER0_TBR_R >= 0x80000000) {
+		WTIMER0_TBV_R = 0;
+	}
+
+	Frecuencimetro_Muestra(&inicio);
+	do {
+		SysCtlDelay(compuerta / 3);
+		Frecuencimetro_Muestra(&fin);
+	} while (fin.flancos == inicio.flancos && ++espera < FREC_ESPERA_MAX);
+
+	m->flancos = fin.flancos - inicio.flancos;
+	m->ciclos = fin.tiempo - inicio.tiempo;
+	m->reciproca = inicio.enFlanco && fin.enFlanco;
+	if (m->flancos == 0 || m->ciclos == 0) {
+		m->hz = 0;
+		m->microHz = 0;
+		return false;
+	}
+
+	// f = N * reloj / T, parte entera y fraccion con la division en dos pasos para no desbordar
+	producto = (uint64_t)m->flancos * reloj;
+	m->hz = (uint32_t)(producto / m->ciclos);
+	m->microHz = (uint32_t)(((producto % m->ciclos) * 1000000) / m->ciclos);
+	return true;
+}
+
+/*
+ * Flancos de bajada contados por el WTimer0B
+ */
+uint32_t Frecuencimetro_Flancos(void) {
+	return WTIMER0_TBR_R;
+}
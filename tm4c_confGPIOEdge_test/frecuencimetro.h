@@ -0,0 +1,43 @@
+/*
+ * frecuencimetro.h
+ *
+ * Frecuencimetro reciproco con el Wide Timer 0. La misma senal entra a dos pines:
+ *  - PC4 (WT0CCP0): WTimer0A en captura de tiempo, guarda el ciclo de reloj del ultimo flanco de bajada
+ *  - PC5 (WT0CCP1): WTimer0B cuenta los flancos de bajada
+ *
+ * La medicion toma una muestra (flancos, tiempo del ultimo flanco) al inicio y al final de la
+ * compuerta: f = N * f_sistema / T, con T medido entre dos flancos, por lo que la resolucion es de un
+ * ciclo de reloj en T sin importar la frecuencia de entrada (1/(T * f_sistema), 2.5e-8 con 1s a 40MHz).
+ * Si la senal es tan rapida que no hay una muestra consistente entre flancos (arriba de ~2MHz), la
+ * medicion usa el tiempo actual del contador y queda como conteo con compuerta (+-1 flanco de N,
+ * que con 1s de compuerta sigue siendo mas de 6 digitos).
+ *
+ * Frecuencia maxima de entrada del GPTM: f_sistema / 4 (10MHz a 40MHz).
+ */
+
+#ifndef FRECUENCIMETRO_H_
+#define FRECUENCIMETRO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Intentos para leer el conteo sin que llegue un flanco entre lecturas
+#define FREC_INTENTOS		4
+// Extensiones de la compuerta si no llego ningun flanco (frecuencias bajas)
+#define FREC_ESPERA_MAX		8
+
+struct medicionFrec {
+	uint32_t flancos;		// N, flancos dentro de la compuerta
+	uint32_t ciclos;		// T, ciclos del reloj del sistema entre los extremos
+	uint32_t hz;			// parte entera de la frecuencia
+	uint32_t microHz;		// parte fraccionaria en millonesimas de Hz
+	bool reciproca;			// true si los dos extremos estan sincronizados a un flanco
+};
+
+typedef struct medicionFrec t_medicionFrec;
+
+void Frecuencimetro_Init(uint32_t relojSistema);
+bool Frecuencimetro_Medir(uint32_t compuerta, t_medicionFrec *m);
+uint32_t Frecuencimetro_Flancos(void);
+
+#endif /* FRECUENCIMETRO_H_ */
@@ -13,78 +13,244 @@
 #include "inc/tm4c123gh6pm.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/interrupt.h"
+#include "driverlib/systick.h"
 
 #include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/uart.h"
+
+#include "antirrebote.h"
+#include "captura.h"
+#include "frecuencimetro.h"
+#include "pin_gpio.h"
+#include "reposo.h"
+// Reloj fijo de SysCtlClockSet (PLL / SYSCTL_SYSDIV_5 = 40MHz, divisor 10 de reloj.h): RELOJ_SISTEMA
+// resuelve los retardos, periodos y el divisor de la UART en tiempo de compilacion
+#define RELOJ_OBJETIVO		40000000
+#include "reloj.h"
+#include "retardo.h"
+#include "divisor.h"
 
 // Comentar para realizar la configuracion con la libreria de perifericos
 #define __conRegistros__
 
+// Descomentar para contar los flancos en PF4 con el Timer2A en lugar de la interrupcion del GPIO
+//#define __CAPTURA_TIMER__
+#define MODO_CAPTURA		CAPTURA_CONTEO		// o CAPTURA_TIEMPO para medir los periodos
+// Lectura de resultados cada 100ms (RETARDO_MS, con RELOJ_SISTEMA = 40MHz), el buffer de
+// CAPTURA_BUFFER periodos alcanza para senales de hasta 640Hz en modo tiempo
+#define LECTURA_CAPTURA		100
+
+// Descomentar para medir la frecuencia de la senal en PC4 y PC5 (unidos) y enviarla por UART0 a 115200
+//#define __FRECUENCIMETRO__
+#define COMPUERTA			CICLOS_US(1000000)	// 1s
+#define BAUD_UART			115200
+typedef char uart_divisorValido[UART_DIVISOR_VALIDO(RELOJ_SISTEMA, BAUD_UART)];
+
+// Periodo de muestreo del antirrebote: 5ms, 4 muestras = 20ms
+#define PERIODO_MUESTREO	CICLOS_US(5000)
+
 // Variables glovales
 unsigned long FallingEdges = 0;
+t_antirrebote boton;
+#ifdef __CAPTURA_TIMER__
+uint32_t periodos[CAPTURA_BUFFER];		// ultimo bloque de periodos en ciclos de reloj
+uint32_t numPeriodos = 0;
+uint32_t periodoMin = 0xffffffff;
+uint32_t periodoMax = 0;
+#endif
+#if !defined(__FRECUENCIMETRO__) && !defined(__CAPTURA_TIMER__)
+t_estadisticasReposo reposo;			// residencia en sleep entre flancos
+#endif
+#ifdef __FRECUENCIMETRO__
+t_medicionFrec medicion;				// ultima medicion, tambien se envia por UART
+#endif
 
 /*
  * Configuracion de entrada en PF4, con pull-up debil interna, interrupciones en flanco de bajada y prioridad 5
+ * El flanco solo arranca el SysTick, que muestrea el boton hasta que se estabiliza y cuenta la presion.
  */
 void EdgeCounter_Init(void){
 #ifdef __conRegistros__
 	// Configuracion utilizando registros
 	SYSCTL_RCGC2_R |= 0x00000020; // (a) activate clock for port F
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
 	FallingEdges = 0;             // (b) initialize count and wait for clock
-	GPIO_PORTF_DIR_R &= ~0x10;    // (c) make PF4 in (built-in button)
-	GPIO_PORTF_AFSEL_R &= ~0x10;  //     disable alt funct on PF4
-	GPIO_PORTF_DEN_R |= 0x10;     //     enable digital I/O on PF4
-	GPIO_PORTF_PCTL_R &= ~0x000F0000; //  configure PF4 as GPIO
-	GPIO_PORTF_AMSEL_R &= ~0x10;  //    disable analog functionality on PF4
-	GPIO_PORTF_PUR_R |= 0x10;     //     enable weak pull-up on PF4
-	GPIO_PORTF_IS_R &= ~0x10;     // (d) PF4 is edge-sensitive
-	GPIO_PORTF_IBE_R &= ~0x10;    //     PF4 is not both edges
-	GPIO_PORTF_IEV_R &= ~0x10;    //     PF4 falling edge event
-	GPIO_PORTF_ICR_R = 0x10;      // (e) clear flag4
-	GPIO_PORTF_IM_R |= 0x10;      // (f) arm interrupt on PF4
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_DIR) &= ~0x10;    // (c) make PF4 in (built-in button)
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_AFSEL) &= ~0x10;  //     disable alt funct on PF4
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_DEN) |= 0x10;     //     enable digital I/O on PF4
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_PCTL) &= ~0x000F0000; //  configure PF4 as GPIO
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_AMSEL) &= ~0x10;  //    disable analog functionality on PF4
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_PUR) |= 0x10;     //     enable weak pull-up on PF4
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_IS) &= ~0x10;     // (d) PF4 is edge-sensitive
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_IBE) &= ~0x10;    //     PF4 is not both edges
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_IEV) &= ~0x10;    //     PF4 falling edge event
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_ICR) = 0x10;      // (e) clear flag4
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_IM) |= 0x10;      // (f) arm interrupt on PF4
 	NVIC_PRI7_R = (NVIC_PRI7_R & 0xFF00FFFF) | 0x00A00000; // (g) priority 5
 	NVIC_EN0_R = 0x40000000;      // (h) enable interrupt 30 in NVIC
+	// SysTick para el antirrebote, detenido hasta el primer flanco, prioridad 5
+	NVIC_ST_CTRL_R = 0;
+	NVIC_ST_RELOAD_R = PERIODO_MUESTREO - 1;
+	NVIC_ST_CURRENT_R = 0;
+	NVIC_SYS_PRI3_R = (NVIC_SYS_PRI3_R & 0x00FFFFFF) | 0xA0000000;
+	NVIC_ST_CTRL_R = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN;
 #else
 	// Configuracion con la libreria
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
 	FallingEdges = 0;
 
-	GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, GPIO_PIN_4);
-	GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_4, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+	GPIOPinTypeGPIOInput(GPIO_PUERTO_F, GPIO_PIN_4);
+	GPIOPadConfigSet(GPIO_PUERTO_F, GPIO_PIN_4, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
 
-	GPIOIntTypeSet(GPIO_PORTF_BASE, GPIO_PIN_4, GPIO_FALLING_EDGE);
-	GPIOIntEnable(GPIO_PORTF_BASE, GPIO_INT_PIN_4);
+	GPIOIntTypeSet(GPIO_PUERTO_F, GPIO_PIN_4, GPIO_FALLING_EDGE);
+	GPIOIntEnable(GPIO_PUERTO_F, GPIO_INT_PIN_4);
 	IntEnable(INT_GPIOF);
 	IntPrioritySet(INT_GPIOF, 5);
+	// SysTick para el antirrebote, detenido hasta el primer flanco
+	SysTickDisable();
+	SysTickPeriodSet(PERIODO_MUESTREO);
+	IntPrioritySet(FAULT_SYSTICK, 0xA0);
+	SysTickIntEnable();
 #endif
 
+	Antirrebote_Init(&boton, GPIO_PUERTO_F, GPIO_PIN_4);
+}
+
+#ifdef __FRECUENCIMETRO__
+/*
+ * Configura UART0 (puerto virtual) como 8N1@115200 para enviar las mediciones
+ */
+static void ConfigurarUART(void) {
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+	GPIOPinConfigure(GPIO_PA0_U0RX);
+	GPIOPinConfigure(GPIO_PA1_U0TX);
+	GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+	Divisor_UART(UART0_BASE, UART_DIVISOR(RELOJ_SISTEMA, BAUD_UART), UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+}
+
+/*
+ * Envia una cadena por UART0
+ */
+static void UART_Texto(const char *texto) {
+	while (*texto) {
+		UARTCharPut(UART0_BASE, *texto++);
+	}
+}
+
+/*
+ * Envia un numero en decimal con al menos "digitos" digitos (con ceros a la izquierda)
+ */
+static void UART_Numero(uint32_t numero, uint32_t digitos) {
+	char buffer[10];
+	uint32_t n = 0;
+
+	do {
+		buffer[n++] = '0' + (numero % 10);
+		numero /= 10;
+	} while (numero != 0 || n < digitos);
+	while (n > 0) {
+		UARTCharPut(UART0_BASE, buffer[--n]);
+	}
 }
+#endif
 
 /*
  * Programa principal
  */
 int main(void) {
+#if defined(__CAPTURA_TIMER__) && !defined(__FRECUENCIMETRO__)
+	uint32_t i;
+#endif
 	
 	// Configurar el reloj a 40MHz
 	SysCtlClockSet(SYSCTL_USE_PLL | SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN | SYSCTL_SYSDIV_5);
+	// Leer el arbol de relojes una vez, lo usa el frecuencimetro
+	Reloj_Leer();
 
+#if defined(__FRECUENCIMETRO__)
+	// Frecuencimetro con el Wide Timer 0 y salida por UART
+	Frecuencimetro_Init(relojes.sistema);
+	ConfigurarUART();
+	IntMasterEnable();
+
+	for(;;) {
+		if (Frecuencimetro_Medir(COMPUERTA, &medicion)) {
+			// "f=12345.678901 Hz N=12345 T=40000000 R" (R: reciproca, G: conteo con compuerta)
+			UART_Texto("f=");
+			UART_Numero(medicion.hz, 1);
+			UART_Texto(".");
+			UART_Numero(medicion.microHz, 6);
+			UART_Texto(" Hz N=");
+			UART_Numero(medicion.flancos, 1);
+			UART_Texto(" T=");
+			UART_Numero(medicion.ciclos, 1);
+			UART_Texto(medicion.reciproca ? " R\r\n" : " G\r\n");
+		} else {
+			UART_Texto("sin senal\r\n");
+		}
+		FallingEdges = Frecuencimetro_Flancos();
+	}
+#elif defined(__CAPTURA_TIMER__)
+	// Contar o medir los flancos de bajada de PF4 en el Timer2A
+	Captura_Init(MODO_CAPTURA);
+	IntMasterEnable();
+
+	for(;;) {
+		// Leer los resultados en bloques
+		RETARDO_MS(LECTURA_CAPTURA);
+		FallingEdges = Captura_Flancos();
+		numPeriodos = Captura_LeerPeriodos(periodos, CAPTURA_BUFFER);
+		for (i = 0; i < numPeriodos; i++) {
+			if (periodos[i] < periodoMin) periodoMin = periodos[i];
+			if (periodos[i] > periodoMax) periodoMax = periodos[i];
+		}
+	}
+#else
 	// Configurar PF4 para detectar un flanco de bajada
 	EdgeCounter_Init();
+	// GPIOF sigue con reloj en sleep, el SysTick es del nucleo; sin timer para medir el reposo
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOF);
+	Reposo_Init(0);
 
 	// Configurar las interrupciones globales
 	IntMasterEnable();
 
 	for(;;) {
-		// esperar interrupciones
+		// dormir hasta el siguiente flanco o muestra del antirrebote
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
 	}
+#endif
 
 }
 
-void IntGPIOPortF_Handler(void) {
-	GPIOIntClear(GPIO_PORTF_BASE, GPIO_INT_PIN_4);
+/*
+ * Flanco de bajada en PF4: se deshabilita la interrupcion del pin durante los rebotes y se arranca el
+ * muestreo del antirrebote, sin esperas dentro de la interrupcion
+ */
+void Int_GPIOF_Handler(void) {
+	GPIOIntClear(GPIO_PUERTO_F, GPIO_INT_PIN_4);
+	GPIOIntDisable(GPIO_PUERTO_F, GPIO_INT_PIN_4);
+	SysTickEnable();
+}
+
+/*
+ * Muestreo del antirrebote cada 5ms mientras el boton esta activo
+ */
+void Int_SysTick_Handler(void) {
+	bool estable = Antirrebote_Muestrear(&boton);
 
-	// Quitar el rebote esperando 1ms
-	SysCtlDelay(40000);
-	if (GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_4) == 0) {
+	if (Antirrebote_Presionados(&boton) & GPIO_PIN_4) {
 		FallingEdges += 1;
 	}
+
+	// Con el boton liberado y estable se vuelve a esperar el siguiente flanco
+	if (estable && (boton.estado & GPIO_PIN_4)) {
+		SysTickDisable();
+		GPIOIntClear(GPIO_PUERTO_F, GPIO_INT_PIN_4);
+		GPIOIntEnable(GPIO_PUERTO_F, GPIO_INT_PIN_4);
+	}
 }
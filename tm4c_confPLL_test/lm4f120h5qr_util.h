@@ -8,8 +8,4 @@
 // Para desbloquear los registros GPIO_CR
 #define GPIO_LOCK_KEY	0x4C4F434B
 
-// Definir el divisor del sistema, la division es 400MHz/(SYSDIV2 + 1)
-#define SYSDIV2	4
-
-// Inicializa el reloj del sistema para trabajar con el PLL a 80MHz
-void PLL_init(void);
+// El reloj del sistema se configura con Reloj_Init (tm4c_common/reloj.c), 80MHz por defecto
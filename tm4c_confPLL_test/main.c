@@ -7,6 +7,7 @@
 
 #include "inc/lm4f120h5qr.h"
 #include "lm4f120h5qr_util.h"
+#include "reloj.h"
 
 // Prototipos de funciones
 void PortF_Init(void);
@@ -17,7 +18,8 @@ unsigned long Out; // output to PF2 (blue LED)
 
 int main(void) {
 	
-	PLL_init();
+	// PLL a RELOJ_OBJETIVO (80MHz), se queda en 16MHz si el cristal o el PLL no arrancan
+	Reloj_Init();
 	PortF_Init();
 
 	while(1) {
@@ -7,6 +7,10 @@
  * Programa para probar la configuracion del modulo 1 PWM en el pin PD0 (M1PWM0) para controlar un motor servo.
  * El programa configura el modulo para trabajar a 50Hz y entre 1ms y 2ms de ciclo de trabajo
  *
+ * El movimiento lo genera un perfil trapezoidal (servo.c) que avanza en la interrupcion de carga
+ * del generador 0, una vez por periodo de 20ms. Los botones y la rutina de demostracion solo cambian
+ * el objetivo, el ciclo principal queda libre.
+ *
  * IMPORTANTE. La librera configura de la siguiente forma el modulo PWM en modo descendente:
  * 		- En el valor de carga pone en alto la salida del generador
  * 		- En el valor de comparacion pone en bajo la salida
@@ -23,67 +27,124 @@
 #include "driverlib/gpio.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/pwm.h"
+#include "driverlib/interrupt.h"
+
+// Reloj del sistema a 40MHz (divisor 10 de reloj.h). RELOJ_OBJETIVO tambien esta predefinido en
+// el proyecto para que reloj.c y servo_pwm.c usen el mismo reloj que servo_cal.h
+#define RELOJ_OBJETIVO		40000000
+#include "reloj.h"
+#include "servo.h"
+#include "servo_pwm.h"
+#include "servo_cal.h"
+#include "pin_gpio.h"
+#include "reposo.h"
 
 // Definiciones
 #define __CONFIGURACION_CON_REGISTROS__
-#define PERIODO_PWM	50000
-#define MAX			6000
-#define MIDPOINT	4250
-#define	MIN			2500
-#define STEP		400
-#define PF0	HWREG(GPIO_PORTF_BASE + 4)
-#define PF4	HWREG(GPIO_PORTF_BASE + 64)
+// Descomentar para manejar todos los servos de la tabla canales[] con servo_pwm.c en lugar de PWM1_Init
+//#define __SERVO_MULTICANAL__
+// PERIODO_PWM, MIN, MIDPOINT y MAX se calculan del reloj en servo_cal.h
+#define STEP		US_A_TICKS(160)	// avance maximo en 40ms con un boton presionado
+#define VEL_MAX		(STEP / 2)		// ticks por periodo de 20ms
+#define ACEL		US_A_TICKS(20)	// ticks por periodo^2
+#define DEMO_PERIODOS	50		// 1s por posicion en la rutina de demostracion
+DEFINIR_PIN(PF0, GPIO_PUERTO_F, GPIO_PIN_0)
+DEFINIR_PIN(PF4, GPIO_PUERTO_F, GPIO_PIN_4)
 
 // Prototipos de funciones
 void PWM1_Init(uint16_t periodo, uint16_t duty);
 void PWM1_Duty(uint16_t duty);
 void Demonstration_routine(uint16_t current);
 void configurarGPIO(void);
+void Int_PWM1Gen0_Handler(void);
+
+// Tabla de servos del modo multicanal. El primer renglon debe ser M1PWM0 porque su interrupcion
+// de carga (Int_PWM1Gen0_Handler) marca los periodos de todos los generadores.
+#ifdef __SERVO_MULTICANAL__
+t_canalServo canales[] = {
+	{PWM1_BASE, PWM_OUT_0, SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_0, GPIO_PD0_M1PWM0},
+	{PWM1_BASE, PWM_OUT_1, SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_1, GPIO_PD1_M1PWM1},
+	{PWM1_BASE, PWM_OUT_2, SYSCTL_PERIPH_GPIOA, GPIO_PORTA_BASE, GPIO_PIN_6, GPIO_PA6_M1PWM2},
+	{PWM1_BASE, PWM_OUT_3, SYSCTL_PERIPH_GPIOA, GPIO_PORTA_BASE, GPIO_PIN_7, GPIO_PA7_M1PWM3},
+	{PWM0_BASE, PWM_OUT_0, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_6, GPIO_PB6_M0PWM0},
+	{PWM0_BASE, PWM_OUT_1, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_7, GPIO_PB7_M0PWM1},
+	{PWM0_BASE, PWM_OUT_2, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_4, GPIO_PB4_M0PWM2},
+	{PWM0_BASE, PWM_OUT_3, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_5, GPIO_PB5_M0PWM3},
+	{PWM0_BASE, PWM_OUT_4, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_4, GPIO_PE4_M0PWM4},
+	{PWM0_BASE, PWM_OUT_5, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_5, GPIO_PE5_M0PWM5},
+	{PWM0_BASE, PWM_OUT_6, SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PIN_4, GPIO_PC4_M0PWM6},
+	{PWM0_BASE, PWM_OUT_7, SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PIN_5, GPIO_PC5_M0PWM7}
+};
+#define NUM_SERVOS	(sizeof(canales) / sizeof(canales[0]))
+#else
+#define NUM_SERVOS	1
+#endif
 
 // Variables globales
 uint16_t duty_cycle;
+t_perfilServo servos[NUM_SERVOS];
+t_estadisticasReposo reposo;		// residencia en sleep entre interrupciones de carga
+
+// Rutina de demostracion: objetivos y paso actual, DEMO_PASOS = inactiva
+#define DEMO_PASOS	4
+uint16_t demoObjetivos[DEMO_PASOS];
+uint8_t demoPaso = DEMO_PASOS;
+uint8_t demoPeriodos = 0;
 
 /*
  * Funcion principal
  */
 int main(void) {
-	// Configuracion del reloj a 40MHz
-	SysCtlClockSet(SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ | SYSCTL_USE_PLL | SYSCTL_SYSDIV_5);
-	// Configuracion del modulo PWM1 con ciclo de trabajo inicial de 1.5ms
-	PWM1_Init(50000, MIDPOINT);
+	uint8_t i;
+
+	// Configuracion del reloj a RELOJ_SISTEMA (40MHz) con el PLL
+	Reloj_Init();
 	// Configurar botones GPIO
 	configurarGPIO();
+	// Perfiles de movimiento en reposo en el punto medio
 	duty_cycle = MIDPOINT;
+	for (i = 0; i < NUM_SERVOS; i++) {
+		Servo_PerfilInit(&servos[i], MIDPOINT, MIN, MAX, VEL_MAX, ACEL);
+	}
+#ifdef __SERVO_MULTICANAL__
+	// Configuracion de todos los canales con ciclo de trabajo inicial de 1.5ms
+	ServoPWM_Init(canales, NUM_SERVOS, PERIODO_PWM, MIDPOINT);
+	// Interrupcion de carga de M1PWM0, prioridad 2
+	PWMGenIntTrigEnable(PWM1_BASE, PWM_GEN_0, PWM_INT_CNT_LOAD);
+	PWMIntEnable(PWM1_BASE, PWM_INT_GEN_0);
+	IntPrioritySet(INT_PWM1_0, 0x40);
+	IntEnable(INT_PWM1_0);
+#else
+	// Configuracion del modulo PWM1 con ciclo de trabajo inicial de 1.5ms
+	PWM1_Init(PERIODO_PWM, MIDPOINT);
+#endif
+	// Perifericos que siguen con reloj mientras el nucleo duerme: botones, PWM y pines de salida
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOF);
+#ifdef __SERVO_MULTICANAL__
+	for (i = 0; i < NUM_SERVOS; i++) {
+		SysCtlPeripheralSleepEnable(canales[i].pwmBase == PWM1_BASE ? SYSCTL_PERIPH_PWM1 : SYSCTL_PERIPH_PWM0);
+		SysCtlPeripheralSleepEnable(canales[i].perifericoGPIO);
+	}
+#else
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_PWM1);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOD);
+#endif
+	// Sin timer periodico para medir el reposo, solo se cuentan las entradas
+	Reposo_Init(0);
+	// Habilitar interrupciones globales
+	IntMasterEnable();
 
 	while (1) {
-		//Demonstration_routine();
-
-		// Rutina de control de posicion
-		if (!PF4) {
-			duty_cycle -= STEP;
-			if (duty_cycle < MIN) {
-				duty_cycle = MIN;
-			}
-			PWM1_Duty(duty_cycle);
-		}
-		if (!PF0) {
-			duty_cycle += STEP;
-			if (duty_cycle > MAX) {
-				duty_cycle = MAX;
-			}
-			PWM1_Duty(duty_cycle);
-		}
-		if (!PF0 && !PF4) {
-			Demonstration_routine(duty_cycle);
-		}
-		SysCtlDelay(533333); // 40ms
-		//SysCtlDelay(266666); // 20ms menor tiempo hace que el motor ejecute mas rapido
+		// El control de posicion se hace en Int_PWM1Gen0_Handler, dormir hasta la siguiente carga
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
 	}
 }
 
 /*
  * Configura el modulo PWM1 en el pin PD0 (M1PWM0)
- * El reloj para el modulo PWM es el divisor de sistema / 16
+ * El reloj para el modulo PWM es el divisor de sistema / PWM_DIV (16 a 40MHz)
+ * Genera una interrupcion en cada carga del contador (inicio de cada periodo de 20ms)
  */
 void PWM1_Init(uint16_t periodo, uint16_t duty) {
 	#ifdef __CONFIGURACION_CON_REGISTROS__
@@ -103,10 +164,12 @@ void PWM1_Init(uint16_t periodo, uint16_t duty) {
 		// Configurar el reloj para el modulo PWM
 		SYSCTL_RCC_R |= SYSCTL_RCC_USEPWMDIV;	// Usar divisor para PWM
 		SYSCTL_RCC_R &= ~SYSCTL_RCC_PWMDIV_M;	// Borrar el campo PWMDIV
-		SYSCTL_RCC_R |= SYSCTL_RCC_PWMDIV_16;	// Divisor de reloj por 16
+		SYSCTL_RCC_R |= PWM_RCC_DIV;			// Divisor de reloj por PWM_DIV
 
 		// Configurar el generador de PWM
-		PWM1_0_CTL_R = 0;	// Modo de recarga
+		// Modo de recarga descendente. LOADUPD = CMPAUPD = 0: carga y comparador sincronizados localmente,
+		// se aplican cuando el contador llega a cero; las acciones del generador tambien
+		PWM1_0_CTL_R = PWM_0_CTL_GENAUPD_LS;
 		PWM1_0_GENA_R = (PWM_0_GENA_ACTCMPAD_ONE | PWM_0_GENA_ACTLOAD_ZERO);	// Configurar acciones de comparador y carga
 		//PWM1_0_GENA_R = (PWM_0_GENA_ACTCMPAD_ZERO | PWM_0_GENA_ACTLOAD_ONE);	// Configuracion como la libreria
 		// No configur PWM1_0_GENB_R porque al final no se mape en pines
@@ -115,12 +178,19 @@ void PWM1_Init(uint16_t periodo, uint16_t duty) {
 		PWM1_0_LOAD_R = periodo - 1;
 		PWM1_0_CMPA_R = duty - 1;
 
+		// Interrupcion en la carga del contador, prioridad 2
+		PWM1_0_INTEN_R = PWM_0_INTEN_INTCNTLOAD;
+		PWM1_0_ISC_R = PWM_0_ISC_INTCNTLOAD;
+		PWM1_INTEN_R |= PWM_INTEN_INTPWM0;
+		NVIC_PRI33_R = (NVIC_PRI33_R & 0xff00ffff) | 0x00400000;
+		NVIC_EN4_R = 0x1 << 6;		// interrupcion 134 (PWM1 generador 0)
+
 		// Iniciar los timers en el generador 0 del modulo 1
 		PWM1_0_CTL_R |= PWM_0_CTL_ENABLE;
 		PWM1_ENABLE_R |= PWM_ENABLE_PWM0EN; // Habilita el generador 0
 	#else
 		// Configurar el reloj para el modulo
-		SysCtlPWMClockSet(SYSCTL_PWMDIV_16);
+		SysCtlPWMClockSet(PWM_DIV_CONFIG);
 		// Habilitar el reloj de los perifericos necesarios
 		SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM1);
 		SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
@@ -128,18 +198,27 @@ void PWM1_Init(uint16_t periodo, uint16_t duty) {
 		GPIOPinTypePWM(GPIO_PORTD_BASE, GPIO_PIN_0);
 		GPIOPinConfigure(GPIO_PD0_M1PWM0);
 		// Configurar el modulo 1 PWM 0 en modo descendente
-		PWMGenConfigure(PWM1_BASE, PWM_GEN_0, PWM_GEN_MODE_DOWN);
+		// PWM_GEN_MODE_NO_SYNC no espera a PWMCTL: el comparador se actualiza en el siguiente cero (sincronizacion local)
+		PWMGenConfigure(PWM1_BASE, PWM_GEN_0, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC | PWM_GEN_MODE_GEN_SYNC_LOCAL);
 		// Cargar el periodo
 		PWMGenPeriodSet(PWM1_BASE, PWM_GEN_0, periodo - 1);
 		// Configurar el duty cycle
 		PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, duty - 1);
 		PWMOutputState(PWM1_BASE, PWM_OUT_0_BIT, true);
+		// Interrupcion en la carga del contador, prioridad 2
+		PWMGenIntTrigEnable(PWM1_BASE, PWM_GEN_0, PWM_INT_CNT_LOAD);
+		PWMIntEnable(PWM1_BASE, PWM_INT_GEN_0);
+		IntPrioritySet(INT_PWM1_0, 0x40);
+		IntEnable(INT_PWM1_0);
 		PWMGenEnable(PWM1_BASE, PWM_GEN_0);
 	#endif
 }
 
 /*
  * Cambia el ciclo de trabajo del modulo PWM1 en el pin PD0 (M1PWM0)
+ * Con sincronizacion local el valor se aplica al terminar el periodo actual, por lo que nunca
+ * produce un pulso cortado. Se llama una vez por periodo desde la interrupcion de carga; dos
+ * escrituras en el mismo periodo pierden la primera.
  */
 void PWM1_Duty(uint16_t duty) {
 	PWM1_0_CMPA_R = duty - 1;
@@ -147,28 +226,16 @@ void PWM1_Duty(uint16_t duty) {
 
 
 /*
- * Crea una rutina de demostracin
+ * Inicia una rutina de demostracin: MIN, MIDPOINT, MAX y regreso a la posicion actual, 1s cada una.
+ * No bloquea, la secuencia la ejecuta Int_PWM1Gen0_Handler.
  */
 void Demonstration_routine(uint16_t current) {
-	#ifdef __CONFIGURACION_CON_REGISTROS__
-		PWM1_Duty(MIN);
-		SysCtlDelay(13333333); // 1s
-		PWM1_Duty(MIDPOINT);
-		SysCtlDelay(13333333);
-		PWM1_Duty(MAX);
-		SysCtlDelay(13333333);
-		PWM1_Duty(current);
-		SysCtlDelay(13333333);
-	#else
-		PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, MIN);
-		SysCtlDelay(13333333); // 1s
-		PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, MIDPOINT);
-		SysCtlDelay(13333333);
-		PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, MAX);
-		SysCtlDelay(13333333);
-		PWMPulseWidthSet(PWM1_BASE, PWM_OUT_0, current);
-		SysCtlDelay(13333333);
-	#endif
+	demoObjetivos[0] = MIN;
+	demoObjetivos[1] = MIDPOINT;
+	demoObjetivos[2] = MAX;
+	demoObjetivos[3] = current;
+	demoPeriodos = 0;
+	demoPaso = 0;
 }
 
 
@@ -178,13 +245,76 @@ void Demonstration_routine(uint16_t current) {
 void configurarGPIO(void) {
 	// Habilitar el reloj al modulo
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
 	// Configuracion de GPIO
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1);
-	GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1, 0xff);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_1);
+	GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1, 0xff);
 	// Desbloquear PF0
-	GPIO_PORTF_LOCK_R = GPIO_LOCK_KEY;	// Desbloquear PF0
-	GPIO_PORTF_CR_R = 0x0f;
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_LOCK) = GPIO_LOCK_KEY;	// Desbloquear PF0
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_CR) = 0x0f;
 	// Configuracion de entradas y pull-up
-	GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, GPIO_PIN_0 | GPIO_PIN_4);
-	GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_0 | GPIO_PIN_4, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+	GPIOPinTypeGPIOInput(GPIO_PUERTO_F, GPIO_PIN_0 | GPIO_PIN_4);
+	GPIOPadConfigSet(GPIO_PUERTO_F, GPIO_PIN_0 | GPIO_PIN_4, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+}
+
+/*
+ * Aplica los botones o el paso actual de la rutina de demostracion al objetivo de un servo
+ */
+static void Servo_Comando(t_perfilServo *s, bool sw1, bool sw2) {
+	if (demoPaso < DEMO_PASOS) {
+		// Rutina de demostracion en curso, cambiar de objetivo cada segundo
+		if (demoPeriodos == 0) {
+			Servo_Objetivo(s, demoObjetivos[demoPaso]);
+		}
+	} else if (sw1) {
+		// Moverse hacia MIN mientras este presionado
+		Servo_Objetivo(s, MIN);
+	} else if (sw2) {
+		// Moverse hacia MAX mientras este presionado
+		Servo_Objetivo(s, MAX);
+	} else if (s->objetivo == MIN || s->objetivo == MAX) {
+		// Boton liberado, frenar donde se alcance
+		Servo_Detener(s);
+	}
+}
+
+/*
+ * Rutina de interrupcion de carga del generador 0 de PWM1, al inicio de cada periodo de 20ms.
+ * Lee los botones, avanza la rutina de demostracion y el perfil, y carga el nuevo ciclo de trabajo.
+ * El comparador esta sincronizado localmente, el nuevo valor se aplica en el siguiente periodo.
+ * En modo multicanal los botones mueven todos los servos y los valores se aplican juntos al
+ * terminar el periodo con ServoPWM_Sync.
+ */
+void Int_PWM1Gen0_Handler(void) {
+	bool sw1, sw2;
+	uint8_t i;
+
+	// Borrar la interrupcion
+	PWM1_0_ISC_R = PWM_0_ISC_INTCNTLOAD;
+
+	// Botones activos en bajo, con ambos presionados inicia la rutina de demostracion
+	sw1 = !PF4_Leer();
+	sw2 = !PF0_Leer();
+	if (demoPaso >= DEMO_PASOS && sw1 && sw2) {
+		Demonstration_routine(duty_cycle);
+	}
+
+	for (i = 0; i < NUM_SERVOS; i++) {
+		Servo_Comando(&servos[i], sw1, sw2);
+	}
+	if (demoPaso < DEMO_PASOS && ++demoPeriodos >= DEMO_PERIODOS) {
+		demoPeriodos = 0;
+		demoPaso++;
+	}
+
+#ifdef __SERVO_MULTICANAL__
+	for (i = 0; i < NUM_SERVOS; i++) {
+		ServoPWM_Duty(i, Servo_PerfilPaso(&servos[i]));
+	}
+	ServoPWM_Sync();
+	duty_cycle = servos[0].posicion;
+#else
+	duty_cycle = Servo_PerfilPaso(&servos[0]);
+	PWM1_Duty(duty_cycle);
+#endif
 }
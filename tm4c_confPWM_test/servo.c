@@ -0,0 +1,111 @@
+/*
+ * servo.c
+ *
+ * Perfil de movimiento trapezoidal para un servo, ver servo.h
+ */
+
+#include "servo.h"
+
+/*
+ * Inicializa el perfil en reposo en la posicion dada
+ */
+void Servo_PerfilInit(t_perfilServo *p, int32_t posicion, int32_t min, int32_t max, int32_t velMax, int32_t acel) {
+	p->min = min;
+	p->max = max;
+	p->velMax = velMax;
+	p->acel = acel;
+	p->velocidad = 0;
+	p->posicion = posicion;
+	p->objetivo = posicion;
+}
+
+/*
+ * Cambia la posicion objetivo, limitada al rango del servo
+ */
+void Servo_Objetivo(t_perfilServo *p, int32_t objetivo) {
+	if (objetivo < p->min) {
+		objetivo = p->min;
+	}
+	if (objetivo > p->max) {
+		objetivo = p->max;
+	}
+	p->objetivo = objetivo;
+}
+
+/*
+ * Distancia que recorre el servo si avanza un periodo a la rapidez dada y luego frena hasta cero
+ */
+static int32_t Servo_DistanciaFrenado(int32_t rapidez, int32_t acel) {
+	int32_t n = (rapidez + acel - 1) / acel;	// periodos hasta detenerse
+	return n * rapidez - (acel * n * (n - 1)) / 2;
+}
+
+/*
+ * Pone como objetivo el punto donde el servo alcanza a frenar con la velocidad actual
+ */
+void Servo_Detener(t_perfilServo *p) {
+	int32_t rapidez = ((p->velocidad >= 0) ? p->velocidad : -p->velocidad) - p->acel;
+	int32_t frenado = (rapidez > 0) ? Servo_DistanciaFrenado(rapidez, p->acel) : 0;
+	Servo_Objetivo(p, p->posicion + (p->velocidad >= 0 ? frenado : -frenado));
+}
+
+/*
+ * Avanza un periodo del perfil y devuelve la nueva posicion.
+ * En cada periodo elige la mayor rapidez entre acelerar, mantener o frenar con la que todavia
+ * alcanza a detenerse en el objetivo, limitada a velMax. El ultimo paso se recorta para no pasarse.
+ */
+int32_t Servo_PerfilPaso(t_perfilServo *p) {
+	int32_t distancia = p->objetivo - p->posicion;
+	int32_t dir = (distancia >= 0) ? 1 : -1;
+	int32_t rapidez, minimo;
+
+	distancia *= dir;
+	rapidez = dir * p->velocidad;
+
+	if (rapidez < 0) {
+		// Se mueve en sentido contrario al objetivo, frenar primero
+		rapidez += p->acel;
+		if (rapidez > 0) {
+			rapidez = 0;
+		}
+	} else {
+		// No frenar mas de acel en un periodo
+		minimo = rapidez - p->acel;
+		rapidez += p->acel;
+		if (rapidez > p->velMax) {
+			rapidez = p->velMax;
+		}
+		while (rapidez > 0 && rapidez > minimo && Servo_DistanciaFrenado(rapidez, p->acel) > distancia) {
+			rapidez -= p->acel;
+			if (rapidez < minimo) {
+				rapidez = minimo;
+			}
+		}
+		if (rapidez <= 0) {
+			// Cerca del objetivo, avanzar lo que falta a baja velocidad
+			rapidez = (distancia < p->acel) ? distancia : p->acel;
+		}
+		if (rapidez > distancia) {
+			rapidez = distancia;
+		}
+	}
+
+	p->velocidad = dir * rapidez;
+	p->posicion += p->velocidad;
+	if (p->posicion < p->min) {
+		p->posicion = p->min;
+		p->velocidad = 0;
+	}
+	if (p->posicion > p->max) {
+		p->posicion = p->max;
+		p->velocidad = 0;
+	}
+	return p->posicion;
+}
+
+/*
+ * Indica si el servo llego al objetivo y esta detenido
+ */
+bool Servo_EnReposo(const t_perfilServo *p) {
+	return p->velocidad == 0 && p->posicion == p->objetivo;
+}
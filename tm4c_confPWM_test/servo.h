@@ -0,0 +1,33 @@
+/*
+ * servo.h
+ *
+ * Perfil de movimiento trapezoidal para un servo. Se avanza un paso por cada periodo de PWM (20ms),
+ * por lo que las velocidades estan en ticks por periodo y la aceleracion en ticks por periodo^2.
+ * No depende de registros, el mismo codigo se prueba en la PC (tm4c_hostSim/servo_perfil.c).
+ */
+
+#ifndef SERVO_H_
+#define SERVO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+struct perfilServo {
+	int32_t posicion;		// valor de comparacion actual
+	int32_t velocidad;		// ticks por periodo, con signo
+	int32_t objetivo;
+	int32_t velMax;
+	int32_t acel;
+	int32_t min;
+	int32_t max;
+};
+
+typedef struct perfilServo t_perfilServo;
+
+void Servo_PerfilInit(t_perfilServo *p, int32_t posicion, int32_t min, int32_t max, int32_t velMax, int32_t acel);
+void Servo_Objetivo(t_perfilServo *p, int32_t objetivo);
+void Servo_Detener(t_perfilServo *p);
+int32_t Servo_PerfilPaso(t_perfilServo *p);
+bool Servo_EnReposo(const t_perfilServo *p);
+
+#endif /* SERVO_H_ */
@@ -0,0 +1,72 @@
+/*
+ * servo_cal.h
+ *
+ * Calibracion del servo derivada del arbol de reloj en tiempo de compilacion.
+ * Al cambiar RELOJ_OBJETIVO se recalculan el divisor del PLL (reloj.h), el divisor del PWM, el
+ * periodo y los valores de comparacion; ninguna de estas constantes hace divisiones en tiempo de ejecucion.
+ *
+ * Ancho de pulso del servo: SERVO_US_MIN (0 grados) a SERVO_US_MAX (SERVO_GRADOS grados)
+ */
+
+#ifndef SERVO_CAL_H_
+#define SERVO_CAL_H_
+
+#include <stdint.h>
+// RELOJ_SISTEMA de reloj.h, con el RELOJ_OBJETIVO del proyecto; Reloj_Init configura el PLL
+#include "reloj.h"
+
+// Frecuencia del servo y calibracion en microsegundos
+#define PWM_FRECUENCIA		50
+#define SERVO_US_MIN		1000
+#define SERVO_US_CENTRO		1700
+#define SERVO_US_MAX		2400
+#define SERVO_GRADOS		180
+
+// Menor divisor del PWM con el que el periodo cabe en el contador de 16 bits
+#define PWM_CICLOS_PERIODO	(RELOJ_SISTEMA / PWM_FRECUENCIA)
+#define PWM_DIV				(PWM_CICLOS_PERIODO <= 2 * 65536 ? 2 : \
+							 PWM_CICLOS_PERIODO <= 4 * 65536 ? 4 : \
+							 PWM_CICLOS_PERIODO <= 8 * 65536 ? 8 : \
+							 PWM_CICLOS_PERIODO <= 16 * 65536 ? 16 : \
+							 PWM_CICLOS_PERIODO <= 32 * 65536 ? 32 : 64)
+#define PWM_DIV_CONFIG		(PWM_DIV == 2 ? SYSCTL_PWMDIV_2 : PWM_DIV == 4 ? SYSCTL_PWMDIV_4 : \
+							 PWM_DIV == 8 ? SYSCTL_PWMDIV_8 : PWM_DIV == 16 ? SYSCTL_PWMDIV_16 : \
+							 PWM_DIV == 32 ? SYSCTL_PWMDIV_32 : SYSCTL_PWMDIV_64)
+#define PWM_RCC_DIV			(PWM_DIV == 2 ? SYSCTL_RCC_PWMDIV_2 : PWM_DIV == 4 ? SYSCTL_RCC_PWMDIV_4 : \
+							 PWM_DIV == 8 ? SYSCTL_RCC_PWMDIV_8 : PWM_DIV == 16 ? SYSCTL_RCC_PWMDIV_16 : \
+							 PWM_DIV == 32 ? SYSCTL_RCC_PWMDIV_32 : SYSCTL_RCC_PWMDIV_64)
+#define PWM_RELOJ			(RELOJ_SISTEMA / PWM_DIV)
+
+// Conversion de constantes de microsegundos a ticks del PWM, redondeada
+#define US_A_TICKS(us)		((uint32_t)(((uint64_t)(us) * PWM_RELOJ + 500000) / 1000000))
+
+// Valores de comparacion (50000, 2500, 4250, 6000 a 40MHz / 16)
+#define PERIODO_PWM			(PWM_RELOJ / PWM_FRECUENCIA)
+#define MIN					US_A_TICKS(SERVO_US_MIN)
+#define MIDPOINT			US_A_TICKS(SERVO_US_CENTRO)
+#define MAX					US_A_TICKS(SERVO_US_MAX)
+#define GRADOS_A_TICKS(g)	(MIN + ((uint32_t)(g) * (MAX - MIN) + SERVO_GRADOS / 2) / SERVO_GRADOS)
+
+// Factores en punto fijo Q16 para convertir valores variables sin dividir
+#define TICKS_POR_US_Q16	((uint32_t)(((uint64_t)PWM_RELOJ << 16) / 1000000))
+#define TICKS_POR_GRADO_Q16	((uint32_t)((((uint64_t)(MAX - MIN)) << 16) / SERVO_GRADOS))
+
+// Verificaciones en tiempo de compilacion (el arreglo tiene tamano negativo si fallan)
+typedef char servoCal_periodo16bits[(PERIODO_PWM <= 65536) ? 1 : -1];
+typedef char servoCal_rangoValido[(MIN < MIDPOINT && MIDPOINT < MAX && MAX < PERIODO_PWM) ? 1 : -1];
+
+/*
+ * Microsegundos a ticks del PWM para valores que cambian en tiempo de ejecucion
+ */
+static inline uint32_t Servo_UsATicks(uint32_t us) {
+	return (uint32_t)(((uint64_t)us * TICKS_POR_US_Q16 + 0x8000) >> 16);
+}
+
+/*
+ * Grados (0 a SERVO_GRADOS) a ticks del PWM para valores que cambian en tiempo de ejecucion
+ */
+static inline uint32_t Servo_GradosATicks(uint32_t grados) {
+	return MIN + ((grados * TICKS_POR_GRADO_Q16 + 0x8000) >> 16);
+}
+
+#endif /* SERVO_CAL_H_ */
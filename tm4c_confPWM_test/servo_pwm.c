@@ -0,0 +1,118 @@
+/*
+ * servo_pwm.c
+ *
+ * Driver de servos en los generadores de PWM0 y PWM1, ver servo_pwm.h
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+
+#include "servo_pwm.h"
+#include "servo_cal.h"
+
+// Variables del driver
+static uint32_t regComparacion[SERVO_MAX_CANALES];	// direccion de CMPA/CMPB de cada canal
+static uint8_t numCanales = 0;
+static uint32_t generadores[2] = {0, 0};			// bits PWM_GEN_n_BIT usados en PWM0 y PWM1
+
+// PWM_OUT_n = PWM_GEN_(n/2) | n: 0x40/0x41, 0x82/0x83, 0xC4/0xC5, 0x106/0x107
+// Base del generador como PWM_OUT_BADDR, numero de generador en los bits 6 en adelante
+#define GENERADOR(salida)	((salida) & 0xFFFFFFC0)
+#define GEN_BIT(salida)		(1 << (((salida) >> 6) - 1))
+#define SALIDA_BIT(salida)	(1 << ((salida) & 0x7))
+#define MODULO(base)		((base) == PWM0_BASE ? 0 : 1)
+
+/*
+ * Configura todos los canales de la tabla con el mismo periodo y ciclo de trabajo inicial
+ */
+void ServoPWM_Init(t_canalServo *tabla, uint8_t canales, uint16_t periodo, uint16_t duty) {
+	uint32_t base, gen;
+	uint8_t i;
+
+	if (canales > SERVO_MAX_CANALES) {
+		canales = SERVO_MAX_CANALES;
+	}
+	numCanales = canales;
+
+	// Configurar el reloj para los modulos PWM
+	SysCtlPWMClockSet(PWM_DIV_CONFIG);
+
+	for (i = 0; i < canales; i++) {
+		base = tabla[i].pwmBase;
+		gen = base + GENERADOR(tabla[i].salida);
+
+		// Habilitar el reloj de los perifericos necesarios
+		SysCtlPeripheralEnable(MODULO(base) ? SYSCTL_PERIPH_PWM1 : SYSCTL_PERIPH_PWM0);
+		SysCtlPeripheralEnable(tabla[i].perifericoGPIO);
+		SysCtlDelay(3);
+
+		// Configurar el pin (PF0 y PD7 deben desbloquearse antes)
+		GPIOPinConfigure(tabla[i].configPin);
+		GPIOPinTypePWM(tabla[i].gpioBase, tabla[i].pin);
+
+		// Configurar el generador la primera vez que aparece en la tabla
+		if ((generadores[MODULO(base)] & GEN_BIT(tabla[i].salida)) == 0) {
+			generadores[MODULO(base)] |= GEN_BIT(tabla[i].salida);
+			HWREG(gen + PWM_O_X_CTL) = 0;	// Modo descendente, deshabilitado
+			// Carga, comparadores y acciones se actualizan solo con sincronizacion global
+			HWREG(gen + PWM_O_X_CTL) = PWM_X_CTL_LOADUPD | PWM_X_CTL_CMPAUPD | PWM_X_CTL_CMPBUPD |
+					PWM_X_CTL_GENAUPD_GS | PWM_X_CTL_GENBUPD_GS;
+			HWREG(gen + PWM_O_X_LOAD) = periodo - 1;
+		}
+
+		// Acciones del generador para la salida A o B y ciclo de trabajo inicial
+		if (tabla[i].salida & 0x1) {
+			HWREG(gen + PWM_O_X_GENB) = PWM_X_GENB_ACTCMPBD_ONE | PWM_X_GENB_ACTLOAD_ZERO;
+			regComparacion[i] = gen + PWM_O_X_CMPB;
+		} else {
+			HWREG(gen + PWM_O_X_GENA) = PWM_X_GENA_ACTCMPAD_ONE | PWM_X_GENA_ACTLOAD_ZERO;
+			regComparacion[i] = gen + PWM_O_X_CMPA;
+		}
+		HWREG(regComparacion[i]) = duty - 1;
+		HWREG(base + PWM_O_ENABLE) |= SALIDA_BIT(tabla[i].salida);
+	}
+
+	// Iniciar los generadores y alinear sus bases de tiempo
+	for (i = 0; i < 2; i++) {
+		base = i ? PWM1_BASE : PWM0_BASE;
+		for (gen = 0; gen < 4; gen++) {
+			if (generadores[i] & (1 << gen)) {
+				HWREG(base + PWM_GEN_0 + (gen << 6) + PWM_O_X_CTL) |= PWM_X_CTL_ENABLE;
+			}
+		}
+	}
+	if (generadores[0]) {
+		HWREG(PWM0_BASE + PWM_O_SYNC) = generadores[0];
+	}
+	if (generadores[1]) {
+		HWREG(PWM1_BASE + PWM_O_SYNC) = generadores[1];
+	}
+	ServoPWM_Sync();
+}
+
+/*
+ * Escribe el valor de comparacion de un canal. No tiene efecto hasta llamar ServoPWM_Sync.
+ */
+void ServoPWM_Duty(uint8_t canal, uint16_t duty) {
+	if (canal < numCanales) {
+		HWREG(regComparacion[canal]) = duty - 1;
+	}
+}
+
+/*
+ * Aplica los valores escritos en todos los canales al terminar el periodo actual (contador en cero)
+ */
+void ServoPWM_Sync(void) {
+	if (generadores[0]) {
+		HWREG(PWM0_BASE + PWM_O_CTL) = generadores[0];
+	}
+	if (generadores[1]) {
+		HWREG(PWM1_BASE + PWM_O_CTL) = generadores[1];
+	}
+}
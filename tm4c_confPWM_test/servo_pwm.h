@@ -0,0 +1,36 @@
+/*
+ * servo_pwm.h
+ *
+ * Driver de hasta 16 servos en los generadores de PWM0 y PWM1, configurados desde una sola tabla.
+ * Todos los generadores usados comparten el periodo, se sincroniza su base de tiempo y los valores de
+ * comparacion se actualizan con sincronizacion global, asi todos los canales cambian en el mismo periodo.
+ *
+ * Igual que PWM1_Init: modo descendente, salida en bajo en la carga y en alto en la comparacion,
+ * reloj del sistema / PWM_DIV (servo_cal.h).
+ */
+
+#ifndef SERVO_PWM_H_
+#define SERVO_PWM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SERVO_MAX_CANALES	16
+
+// Un renglon de la tabla por cada servo
+struct canalServo {
+	uint32_t pwmBase;		// PWM0_BASE o PWM1_BASE
+	uint32_t salida;		// PWM_OUT_0 ... PWM_OUT_7
+	uint32_t perifericoGPIO;// SYSCTL_PERIPH_GPIOx del pin
+	uint32_t gpioBase;		// GPIO_PORTx_BASE del pin
+	uint8_t pin;			// GPIO_PIN_x
+	uint32_t configPin;		// GPIO_Pxy_MnPWMz de pin_map.h
+};
+
+typedef const struct canalServo t_canalServo;
+
+void ServoPWM_Init(t_canalServo *tabla, uint8_t canales, uint16_t periodo, uint16_t duty);
+void ServoPWM_Duty(uint8_t canal, uint16_t duty);
+void ServoPWM_Sync(void);
+
+#endif /* SERVO_PWM_H_ */
@@ -18,43 +18,72 @@
 #include "driverlib/ssi.h"
 #include "driverlib/gpio.h"
 #include "driverlib/pin_map.h"
+#include "driverlib/interrupt.h"
 
+#include "ssi_clock.h"
+#include "tlv5616.h"
 
-#define DAC_SPD_FAST	0x4000
-#define DAC_SPD_SLOW	0x0000
-#define DAC_PWR_DOWN	0x2000
-#define DAC_PWR_NORMAL	0x0000
+// Reloj del sistema con el PLL a RELOJ_OBJETIVO (80MHz por defecto), define RELOJ_SISTEMA para los retardos
+#include "reloj.h"
+#include "retardo.h"
 
 //#define __CONFIGURACION_CON_REGISTROS__
+// Descomentar para medir palabras/segundo de DAC_Out contra DAC_OutBlock al iniciar
+//#define __BENCHMARK_DAC__
+
+#define BENCH_PALABRAS	256
 
 
 // Prototipos
 void SSI0_Init(void);
 void SSI0_Out(unsigned short);
 void DAC_Out(unsigned short);
+void DAC_OutBlock(const uint16_t *codes, uint32_t n);
+bool DAC_BlockBusy(void);
+void DAC_Benchmark(void);
+
+// Configuracion del reloj de SSI0 calculada en SSI0_Init
+t_planSSI planSSI;
+
+// Variables globales para el envio por bloques, compartidas con Int_SSI0_Handler
+const uint16_t *bloqueDatos;
+volatile uint32_t bloqueRestantes = 0;
+
+#ifdef __BENCHMARK_DAC__
+// Resultados del benchmark, para revisarlos con el debugger
+uint16_t benchDatos[BENCH_PALABRAS];
+uint32_t ciclosLoop = 0, ciclosBloque = 0, ciclosLlamadaBloque = 0;
+uint32_t palabrasSegLoop = 0, palabrasSegBloque = 0;
+#endif
 
 /*
  * Funcion principal
  */
 int main(void) {
-	// Configuracion del reloj a 40MHz
-	SysCtlClockSet(SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ | SYSCTL_USE_PLL | SYSCTL_SYSDIV_5);
+	// Configuracion del reloj a RELOJ_SISTEMA
+	Reloj_Init();
 
 	// Configurar la interfaz SSI
 	SSI0_Init();
+	// Habilitar interrupciones globales para el envio por bloques
+	IntMasterEnable();
+
+#ifdef __BENCHMARK_DAC__
+	DAC_Benchmark();
+#endif
 
 	while (1) {
 		// Enviar un dato
 		DAC_Out(100);
-		SysCtlDelay(26666666);
+		RETARDO_MS(2000);
 		DAC_Out(500);
-		SysCtlDelay(26666666);
+		RETARDO_MS(2000);
 		DAC_Out(1000);
-		SysCtlDelay(26666666);
+		RETARDO_MS(2000);
 		DAC_Out(2000);
-		SysCtlDelay(26666666);
+		RETARDO_MS(2000);
 		SSIDataPutNonBlocking(SSI0_BASE, 2500);
-		SysCtlDelay(26666666);
+		RETARDO_MS(2000);
 	}
 }
 
@@ -65,8 +94,14 @@ int main(void) {
  * Notas: El formato Freescale SPI con SPO=1 y SPH=1 funciona bien con el TLV5616,
  * 	pero en cambio se configura con el formato TI, que es especifico para este integrado
  *
+ * 	El CPSDVSR/SCR lo calcula SSI_PlanReloj para el reloj del sistema actual, con la mayor
+ * 	frecuencia que cumple los tiempos del TLV5616 (10MHz@40MHz, 20MHz@80MHz)
+ *
  */
 void SSI0_Init(void) {
+	// Calcular el prescaler y el SCR, siempre hay solucion hasta 80MHz
+	SSI_PlanReloj(Reloj_Frecuencia(), &planSSI);
+
 	#ifdef __CONFIGURACION_CON_REGISTROS__
 		volatile unsigned long delay;
 		// Habilitar el modulo SSI y el puerto A
@@ -88,16 +123,21 @@ void SSI0_Init(void) {
 		SSI0_CR1_R &= ~SSI_CR1_MS;
 		// Configurar la fuente de reloj como reloj del sistema basado en un factor de division
 		SSI0_CC_R &= ~SSI_CC_CS_M;
-		// Configurar el prescaler para una frecuencia del modulo SSI de 1Mhz = 40MHz/40
-		SSI0_CPSR_R = (SSI0_CPSR_R & ~SSI_CPSR_CPSDVSR_M) + 20;
+		// Configurar el prescaler calculado por el planificador
+		SSI0_CPSR_R = (SSI0_CPSR_R & ~SSI_CPSR_CPSDVSR_M) + planSSI.cpsdvsr;
 		// Configurar el serial clock rate, polaridad del reloj y fase, protocolo y tamao de los datos
-		SSI0_CR0_R &= ~(SSI_CR0_SCR_M); 	// SCR = 0
+		SSI0_CR0_R = (SSI0_CR0_R & ~SSI_CR0_SCR_M) + (planSSI.scr << SSI_CR0_SCR_S);
 	//	SSI0_CR0_R |= SSI_CR0_SPO;			// SPO = 1
 	//	SSI0_CR0_R |= SSI_CR0_SPH;			// SPH = 1
 	//	SSI0_CR0_R = (SSI0_CR0_R & ~SSI_CR0_FRF_M) + SSI_CR0_FRF_MOTO;	// Freescale SPI
 		SSI0_CR0_R = (SSI0_CR0_R & ~SSI_CR0_FRF_M) + SSI_CR0_FRF_TI;	// Texas Instruments Synchronous Serial Frame Format
 		SSI0_CR0_R = (SSI0_CR0_R & ~SSI_CR0_DSS_M) + SSI_CR0_DSS_16;	// 16 bits de datos
 
+		// Interrupcion de FIFO de transmision medio vacia para DAC_OutBlock, se arma al enviar un bloque
+		SSI0_IM_R &= ~SSI_IM_TXIM;
+		NVIC_PRI1_R = (NVIC_PRI1_R & 0x00ffffff) | 0x40000000;	// prioridad 2
+		NVIC_EN0_R = 0x1 << 7;									// interrupcion 7 (SSI0)
+
 		// Finalmente, habilitar el modulo SPI
 		SSI0_CR1_R |= SSI_CR1_SSE;
 	#else
@@ -112,7 +152,16 @@ void SSI0_Init(void) {
 		GPIOPinTypeSSI(GPIO_PORTA_BASE, GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_5);
 
 		// Configurar el modulo SSI y habilitarlo
-		SSIConfigSetExpClk(SSI0_BASE, SysCtlClockGet(), SSI_FRF_TI, SSI_MODE_MASTER, 2000000, 16);
+		SSIConfigSetExpClk(SSI0_BASE, Reloj_Frecuencia(), SSI_FRF_TI, SSI_MODE_MASTER, planSSI.bitRate, 16);
+		// La libreria puede descomponer el divisor de otra forma, usar la misma que la rama de registros
+		SSI0_CPSR_R = planSSI.cpsdvsr;
+		SSI0_CR0_R = (SSI0_CR0_R & ~SSI_CR0_SCR_M) + (planSSI.scr << SSI_CR0_SCR_S);
+
+		// Interrupcion de FIFO de transmision medio vacia para DAC_OutBlock, se arma al enviar un bloque
+		SSIIntDisable(SSI0_BASE, SSI_TXFF);
+		IntPrioritySet(INT_SSI0, 0x40);	// prioridad 2
+		IntEnable(INT_SSI0);
+
 		SSIEnable(SSI0_BASE);
 	#endif
 }
@@ -123,5 +172,100 @@ void SSI0_Out(unsigned short code) {
 }
 
 void DAC_Out(unsigned short code) {
-	SSI0_Out((code & 0xfff) + DAC_SPD_SLOW + DAC_PWR_NORMAL);
+	SSI0_Out(DAC_TRAMA(code, DAC_SPD_SLOW + DAC_PWR_NORMAL));
+}
+
+/*
+ * Llena la FIFO de transmision (8 palabras) con los codigos pendientes del bloque actual
+ */
+static void SSI0_LlenarFIFO(void) {
+	while (bloqueRestantes && (SSI0_SR_R & SSI_SR_TNF)) {
+		SSI0_DR_R = DAC_TRAMA(*bloqueDatos++, DAC_SPD_SLOW + DAC_PWR_NORMAL);
+		bloqueRestantes--;
+	}
+}
+
+/*
+ * Envia n codigos al DAC sin esperar palabra por palabra.
+ * La FIFO se llena en rafagas aqui y en Int_SSI0_Handler cuando queda medio vacia.
+ * El arreglo no debe modificarse hasta que DAC_BlockBusy() devuelva false.
+ */
+void DAC_OutBlock(const uint16_t *codes, uint32_t n) {
+	// Esperar a que termine el bloque anterior
+	while (bloqueRestantes) {};
+	if (n == 0) {
+		return;
+	}
+
+	bloqueDatos = codes;
+	bloqueRestantes = n;
+	SSI0_LlenarFIFO();
+
+	// Si no cupo todo, la interrupcion de FIFO medio vacia completa el envio
+	if (bloqueRestantes) {
+		SSI0_IM_R |= SSI_IM_TXIM;
+	}
+}
+
+/*
+ * Indica si quedan codigos del bloque por poner en la FIFO
+ */
+bool DAC_BlockBusy(void) {
+	return bloqueRestantes != 0;
+}
+
+/*
+ * Rutina de interrupcion de SSI0, FIFO de transmision medio vacia o menos
+ */
+void Int_SSI0_Handler(void) {
+	// La interrupcion TXRIS no se borra con ICR, se mantiene mientras la FIFO este medio vacia
+	SSI0_LlenarFIFO();
+	if (bloqueRestantes == 0) {
+		SSI0_IM_R &= ~SSI_IM_TXIM;
+	}
+}
+
+#ifdef __BENCHMARK_DAC__
+/*
+ * Compara el envio palabra por palabra (DAC_Out) contra el envio por bloques (DAC_OutBlock).
+ * Usa SysTick con el reloj del sistema como contador de ciclos (24 bits, ~419ms@40MHz).
+ * ciclosLlamadaBloque es el tiempo que el CPU queda bloqueado en la llamada a DAC_OutBlock.
+ */
+void DAC_Benchmark(void) {
+	uint32_t i, inicio, reloj;
+
+	// Rampa de prueba
+	for (i = 0; i < BENCH_PALABRAS; i++) {
+		benchDatos[i] = (i << 4) & 0xfff;
+	}
+
+	// SysTick libre, sin interrupciones
+	NVIC_ST_CTRL_R = 0;
+	NVIC_ST_RELOAD_R = 0x00ffffff;
+	NVIC_ST_CURRENT_R = 0;
+	NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE | NVIC_ST_CTRL_CLK_SRC;
+
+	// 1. Ciclo palabra por palabra
+	inicio = NVIC_ST_CURRENT_R;
+	for (i = 0; i < BENCH_PALABRAS; i++) {
+		DAC_Out(benchDatos[i]);
+	}
+	while (SSI0_SR_R & SSI_SR_BSY) {};
+	ciclosLoop = (inicio - NVIC_ST_CURRENT_R) & 0x00ffffff;
+
+	// 2. Envio por bloques
+	inicio = NVIC_ST_CURRENT_R;
+	DAC_OutBlock(benchDatos, BENCH_PALABRAS);
+	ciclosLlamadaBloque = (inicio - NVIC_ST_CURRENT_R) & 0x00ffffff;
+	while (DAC_BlockBusy()) {};
+	while (SSI0_SR_R & SSI_SR_BSY) {};
+	ciclosBloque = (inicio - NVIC_ST_CURRENT_R) & 0x00ffffff;
+
+	NVIC_ST_CTRL_R = 0;
+
+	// Palabras por segundo = palabras * f_sistema / ciclos
+	reloj = Reloj_Frecuencia();
+	palabrasSegLoop = (uint32_t)(((uint64_t)BENCH_PALABRAS * reloj) / ciclosLoop);
+	palabrasSegBloque = (uint32_t)(((uint64_t)BENCH_PALABRAS * reloj) / ciclosBloque);
 }
+#endif
@@ -0,0 +1,75 @@
+/*
+ * ssi_clock.c
+ *
+ * Planificador del reloj de SSI0 para el DAC TLV5616. Lo usan las dos ramas de SSI0_Init
+ * (registros y libreria) para que ambas configuren exactamente el mismo CPSDVSR/SCR.
+ */
+
+#include "ssi_clock.h"
+
+#define PS_POR_SEGUNDO	1000000000000ULL
+
+/*
+ * Evalua los margenes de tiempo para un divisor total de SSIClk (CPSDVSR * (1 + SCR))
+ *
+ * En el formato TI el SSI pone FSS en alto un periodo antes del MSB, cambia TX en el flanco
+ * de subida y el TLV5616 lee DIN en el flanco de bajada. SSIClk tiene ciclo de trabajo de 50%.
+ */
+static bool TLV5616_TiemposDivisor(uint32_t relojSistema, uint32_t divisor, t_tiemposTLV5616 *t) {
+	int32_t periodo, medio, retardo;
+
+	periodo = (int32_t)((PS_POR_SEGUNDO * divisor) / relojSistema);
+	medio = periodo / 2;
+	retardo = (int32_t)((PS_POR_SEGUNDO * SSI_RETARDO_CICLOS) / relojSistema);
+
+	t->periodo = periodo - (int32_t)(PS_POR_SEGUNDO / TLV5616_FSCLK_MAX);
+	t->wh = medio - TLV5616_TWH_NS * 1000;
+	t->wl = medio - TLV5616_TWL_NS * 1000;
+	// DIN cambia en la subida (mas el retardo) y se lee en la bajada
+	t->setupDatos = medio - retardo - TLV5616_TSU_D_NS * 1000;
+	// Peor caso: el siguiente bit cambia justo en la subida, sin retardo
+	t->holdDatos = medio - TLV5616_TH_D_NS * 1000;
+	// FS baja junto con el MSB en la subida, el TLV5616 lo lee en la bajada
+	t->setupFS = medio - retardo - TLV5616_TSU_FS_NS * 1000;
+	// Del flanco de bajada 16 a la subida de FS de la trama siguiente (transmision continua)
+	t->c16FS = medio - TLV5616_TSU_C16_NS * 1000;
+	// FS dura un periodo completo de SSIClk
+	t->anchoFS = periodo - TLV5616_TW_FS_NS * 1000;
+
+	return (t->periodo >= 0) && (t->wh >= 0) && (t->wl >= 0) && (t->setupDatos >= 0) &&
+			(t->holdDatos >= 0) && (t->setupFS >= 0) && (t->c16FS >= 0) && (t->anchoFS >= 0);
+}
+
+/*
+ * Evalua los tiempos de una trama TI de 16 bits con el CPSDVSR/SCR dado
+ */
+bool TLV5616_Tiempos(uint32_t relojSistema, uint8_t cpsdvsr, uint8_t scr, t_tiemposTLV5616 *t) {
+	return TLV5616_TiemposDivisor(relojSistema, (uint32_t)cpsdvsr * (1 + scr), t);
+}
+
+/*
+ * Busca el menor divisor total (mayor frecuencia de SSIClk) que cumple los tiempos del TLV5616
+ * y lo descompone en CPSDVSR/SCR. Los margenes solo dependen del divisor total, por lo que
+ * basta con recorrer los divisores pares de menor a mayor.
+ * Devuelve false si el reloj del sistema es tan alto que no hay divisor valido.
+ */
+bool SSI_PlanReloj(uint32_t relojSistema, t_planSSI *plan) {
+	t_tiemposTLV5616 t;
+	uint32_t divisor, cps;
+
+	for (divisor = 2; divisor <= 254 * 256; divisor += 2) {
+		if (!TLV5616_TiemposDivisor(relojSistema, divisor, &t)) {
+			continue;
+		}
+		// Preferir el prescaler mas pequeno que permita un SCR valido
+		for (cps = 2; cps <= 254; cps += 2) {
+			if ((divisor % cps) == 0 && (divisor / cps) <= 256) {
+				plan->cpsdvsr = cps;
+				plan->scr = (divisor / cps) - 1;
+				plan->bitRate = relojSistema / divisor;
+				return true;
+			}
+		}
+	}
+	return false;
+}
@@ -0,0 +1,58 @@
+/*
+ * ssi_clock.h
+ *
+ * Planificador del reloj de SSI0 para el DAC TLV5616 y modelo de tiempos de la trama.
+ * Solo utiliza aritmetica entera, por lo que tambien se compila en la PC (tm4c_hostSim).
+ *
+ * El reloj de SSI es: f_SSI = f_sistema / (CPSDVSR * (1 + SCR)), CPSDVSR par de 2 a 254, SCR de 0 a 255
+ */
+
+#ifndef SSI_CLOCK_H_
+#define SSI_CLOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tiempos minimos del TLV5616 en ns (hoja de datos, VDD = 2.7V a 5.5V)
+#define TLV5616_FSCLK_MAX	20000000	// frecuencia maxima de SCLK
+#define TLV5616_TWH_NS		25			// ancho de SCLK en alto
+#define TLV5616_TWL_NS		25			// ancho de SCLK en bajo
+#define TLV5616_TSU_D_NS	8			// setup de DIN antes del flanco de bajada de SCLK
+#define TLV5616_TH_D_NS		5			// hold de DIN despues del flanco de bajada de SCLK
+#define TLV5616_TSU_FS_NS	8			// setup de FS (bajada) antes del flanco de bajada de SCLK
+#define TLV5616_TSU_C16_NS	10			// del flanco 16 de SCLK a la subida de FS de la siguiente trama
+#define TLV5616_TW_FS_NS	20			// ancho minimo de FS en alto
+
+// El SSI cambia TX y FSS un ciclo del sistema despues del flanco de subida de SSIClk (peor caso)
+#define SSI_RETARDO_CICLOS	1
+
+// Resultado del planificador
+struct planSSI {
+	uint8_t cpsdvsr;		// prescaler, SSI_CPSR
+	uint8_t scr;			// serial clock rate, campo SCR de SSI_CR0
+	uint32_t bitRate;		// frecuencia resultante de SSIClk en Hz
+};
+
+typedef struct planSSI t_planSSI;
+
+// Margenes del modelo de tiempos en ps, negativo si se viola la restriccion
+struct tiemposTLV5616 {
+	int32_t periodo;		// periodo de SCLK
+	int32_t wh;				// ancho en alto - TWH
+	int32_t wl;				// ancho en bajo - TWL
+	int32_t setupDatos;		// setup de DIN - TSU_D
+	int32_t holdDatos;		// hold de DIN - TH_D
+	int32_t setupFS;		// setup de FS - TSU_FS
+	int32_t c16FS;			// flanco 16 a FS - TSU_C16
+	int32_t anchoFS;		// ancho de FS - TW_FS
+};
+
+typedef struct tiemposTLV5616 t_tiemposTLV5616;
+
+// Evalua los tiempos de una trama TI de 16 bits, devuelve true si todos los margenes son >= 0
+bool TLV5616_Tiempos(uint32_t relojSistema, uint8_t cpsdvsr, uint8_t scr, t_tiemposTLV5616 *t);
+
+// Busca el CPSDVSR/SCR con la mayor frecuencia que cumple los tiempos del TLV5616
+bool SSI_PlanReloj(uint32_t relojSistema, t_planSSI *plan);
+
+#endif /* SSI_CLOCK_H_ */
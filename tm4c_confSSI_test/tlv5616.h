@@ -0,0 +1,22 @@
+/*
+ * tlv5616.h
+ *
+ * Formato de la trama de 16 bits del DAC TLV5616, compartido con el modelo de tm4c_hostSim.
+ *
+ * 	D15		D14		D13		D12		D11..D0
+ * 	X		SPD		PWR		X		codigo de 12 bits
+ */
+
+#ifndef TLV5616_H_
+#define TLV5616_H_
+
+#define DAC_SPD_FAST	0x4000
+#define DAC_SPD_SLOW	0x0000
+#define DAC_PWR_DOWN	0x2000
+#define DAC_PWR_NORMAL	0x0000
+#define DAC_CODIGO_M	0x0fff
+
+// Arma la trama con el codigo y los bits de velocidad y potencia
+#define DAC_TRAMA(code, modo)	(((code) & DAC_CODIGO_M) + (modo))
+
+#endif /* TLV5616_H_ */
@@ -0,0 +1,187 @@
+/*
+ * analizador.c
+ *
+ * Analizador logico del puerto F con Timer0A + uDMA, ver analizador.h
+ */
+
+#include "analizador.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_gpio.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/gpio.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+#include "driverlib/interrupt.h"
+#include "pin_gpio.h"
+
+// Canal del uDMA del Timer0A, estructura primaria (bloques pares) y alterna (bloques impares)
+#define CANAL_PRI	(UDMA_CH18_TIMER0A | UDMA_PRI_SELECT)
+#define CANAL_ALT	(UDMA_CH18_TIMER0A | UDMA_ALT_SELECT)
+#define CANAL(b)	(((b) & 1) ? CANAL_ALT : CANAL_PRI)
+
+// Tabla de control del uDMA, debe estar alineada a 1024 bytes
+#pragma DATA_ALIGN(tablaControl, 1024)
+static uint8_t tablaControl[1024];
+
+static uint8_t muestras[ANALIZADOR_MUESTRAS];
+
+static uint32_t frecuenciaMuestreo;
+static uint32_t muestrasPre, muestrasPost;
+static volatile uint32_t bloquesCompletos;		// bloques llenos desde Analizador_Iniciar
+static volatile uint32_t bloqueFinal;			// detener al completar este numero de bloques
+static volatile uint32_t disparo;				// muestra del disparo, contada desde el inicio
+static volatile bool disparado;
+static volatile bool terminado;
+
+/*
+ * Arma la estructura del uDMA que corresponde al bloque absoluto b
+ */
+static void Analizador_ArmarBloque(uint32_t b) {
+	uDMAChannelTransferSet(CANAL(b), UDMA_MODE_PINGPONG,
+			(void *)(GPIO_PUERTO_F + GPIO_O_DATA + (0xff << 2)),
+			&muestras[(b % ANALIZADOR_BLOQUES) * ANALIZADOR_BLOQUE], ANALIZADOR_BLOQUE);
+}
+
+/*
+ * Configura el Timer0A a la frecuencia de muestreo, el canal 18 del uDMA y el disparo en el puerto F.
+ * El puerto F ya debe estar habilitado. Devuelve false si la ventana pre + post no cabe en el buffer.
+ */
+bool Analizador_Init(uint32_t relojSistema, uint32_t frecuencia, uint32_t pre, uint32_t post) {
+	if (pre + post > ANALIZADOR_MAX_VENTANA || post == 0 || frecuencia == 0) {
+		return false;
+	}
+	frecuenciaMuestreo = frecuencia;
+	muestrasPre = pre;
+	muestrasPost = post;
+
+	// Timer0A periodico, cada timeout es una peticion al uDMA
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+	TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
+	TimerLoadSet(TIMER0_BASE, TIMER_A, relojSistema / frecuencia - 1);
+
+	// uDMA: un byte del registro DATA por peticion, destino incremental
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+	uDMAEnable();
+	uDMAControlBaseSet(tablaControl);
+	uDMAChannelAssign(UDMA_CH18_TIMER0A);
+	uDMAChannelAttributeDisable(UDMA_CH18_TIMER0A, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+			UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+	uDMAChannelAttributeEnable(UDMA_CH18_TIMER0A, UDMA_ATTR_HIGH_PRIORITY);
+	uDMAChannelControlSet(CANAL_PRI, UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_1);
+	uDMAChannelControlSet(CANAL_ALT, UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_1);
+
+	// El fin de cada bloque llega por la interrupcion del Timer0A
+	IntPrioritySet(INT_TIMER0A, 0x20);
+
+	// Disparo por flanco de bajada, misma prioridad para que no se interrumpan entre si
+	GPIOIntTypeSet(GPIO_PUERTO_F, ANALIZADOR_DISPARO, GPIO_FALLING_EDGE);
+	IntPrioritySet(INT_GPIOF, 0x20);
+
+	return true;
+}
+
+/*
+ * Inicia una captura nueva
+ */
+void Analizador_Iniciar(void) {
+	bloquesCompletos = 0;
+	bloqueFinal = 0xffffffff;
+	disparado = false;
+	terminado = false;
+
+	Analizador_ArmarBloque(0);
+	Analizador_ArmarBloque(1);
+	uDMAChannelEnable(UDMA_CH18_TIMER0A);
+	IntEnable(INT_TIMER0A);
+
+	GPIOIntClear(GPIO_PUERTO_F, ANALIZADOR_DISPARO);
+	GPIOIntEnable(GPIO_PUERTO_F, ANALIZADOR_DISPARO);
+	IntEnable(INT_GPIOF);
+
+	TimerEnable(TIMER0_BASE, TIMER_A);
+}
+
+bool Analizador_Terminado(void) {
+	return terminado;
+}
+
+/*
+ * Fin de un bloque del uDMA (interrupcion del Timer0A). Llamar desde Int_Timer0A_Handler.
+ * Se vuelve a armar la estructura que termino con el bloque que sigue al que se esta llenando.
+ */
+void Analizador_Timer0(void) {
+	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+
+	while (!terminado && uDMAChannelModeGet(CANAL(bloquesCompletos)) == UDMA_MODE_STOP) {
+		bloquesCompletos += 1;
+		if (bloquesCompletos >= bloqueFinal) {
+			TimerDisable(TIMER0_BASE, TIMER_A);
+			uDMAChannelDisable(UDMA_CH18_TIMER0A);
+			IntDisable(INT_TIMER0A);
+			terminado = true;
+		} else {
+			Analizador_ArmarBloque(bloquesCompletos + 1);
+		}
+	}
+}
+
+/*
+ * Disparo: posicion actual del uDMA y bloque en el que se completan las muestras post disparo
+ */
+void Int_GPIOF_Handler(void) {
+	uint32_t restantes;
+
+	GPIOIntClear(GPIO_PUERTO_F, ANALIZADOR_DISPARO);
+	if (disparado || terminado) {
+		return;
+	}
+	GPIOIntDisable(GPIO_PUERTO_F, ANALIZADOR_DISPARO);
+
+	// Si el bloque actual ya termino y su interrupcion esta pendiente, el tamano restante es 0
+	restantes = uDMAChannelSizeGet(CANAL(bloquesCompletos));
+	disparo = bloquesCompletos * ANALIZADOR_BLOQUE + (ANALIZADOR_BLOQUE - restantes);
+	bloqueFinal = (disparo + muestrasPost + ANALIZADOR_BLOQUE - 1) / ANALIZADOR_BLOQUE;
+	disparado = true;
+}
+
+/*
+ * Envia la ventana capturada con codificacion por longitud de corridas, byte por byte con "enviar"
+ */
+void Analizador_Volcar(void (*enviar)(uint8_t dato)) {
+	uint32_t inicio, total, i;
+	uint8_t valor, siguiente, repeticiones;
+
+	// La ventana empieza "pre" muestras antes del disparo, o en la primera muestra capturada
+	inicio = (disparo > muestrasPre) ? disparo - muestrasPre : 0;
+	total = disparo + muestrasPost - inicio;
+
+	enviar(ANALIZADOR_CABECERA_0);
+	enviar(ANALIZADOR_CABECERA_1);
+	for (i = 0; i < 32; i += 8) {
+		enviar((uint8_t)(frecuenciaMuestreo >> i));
+	}
+	enviar((uint8_t)total);
+	enviar((uint8_t)(total >> 8));
+	enviar((uint8_t)(disparo - inicio));
+	enviar((uint8_t)((disparo - inicio) >> 8));
+
+	valor = muestras[inicio % ANALIZADOR_MUESTRAS];
+	repeticiones = 1;
+	for (i = 1; i < total; i++) {
+		siguiente = muestras[(inicio + i) % ANALIZADOR_MUESTRAS];
+		if (siguiente == valor && repeticiones < ANALIZADOR_MAX_REPETICIONES) {
+			repeticiones += 1;
+		} else {
+			enviar(valor);
+			enviar(repeticiones);
+			valor = siguiente;
+			repeticiones = 1;
+		}
+	}
+	enviar(valor);
+	enviar(repeticiones);
+	enviar(0);
+	enviar(0);
+}
@@ -0,0 +1,44 @@
+/*
+ * analizador.h
+ *
+ * Analizador logico del puerto F. El Timer0A marca la frecuencia de muestreo y en cada timeout
+ * pide una transferencia al uDMA (canal 18) que copia el registro DATA del puerto a RAM, sin
+ * interrupciones por muestra. El buffer se llena en bloques en modo ping-pong de forma circular
+ * hasta que llega el disparo (flanco de bajada en ANALIZADOR_DISPARO) y luego se capturan
+ * "post" muestras mas; la ventana tiene "pre" muestras antes del disparo.
+ *
+ * Formato del volcado (binario, se decodifica con tm4c_hostSim/la_vcd.c):
+ *   'L' 'A', frecuencia (32 bits), muestras (16 bits), posicion del disparo (16 bits), little endian
+ *   pares (valor, repeticiones) con repeticiones de 1 a 255
+ *   fin: 0x00 0x00
+ */
+
+#ifndef ANALIZADOR_H_
+#define ANALIZADOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Profundidad: ANALIZADOR_BLOQUES bloques de ANALIZADOR_BLOQUE muestras (maximo 1024 por transferencia)
+#define ANALIZADOR_BLOQUE		256
+#define ANALIZADOR_BLOQUES		8
+#define ANALIZADOR_MUESTRAS		(ANALIZADOR_BLOQUE * ANALIZADOR_BLOQUES)
+// pre + post no puede pasar de ANALIZADOR_MAX_VENTANA (el ultimo bloque se sigue escribiendo al detener)
+#define ANALIZADOR_MAX_VENTANA	(ANALIZADOR_MUESTRAS - 2 * ANALIZADOR_BLOQUE)
+
+// Pin de disparo en el puerto F (SW1)
+#define ANALIZADOR_DISPARO		0x10
+
+// Cabecera y fin del volcado
+#define ANALIZADOR_CABECERA_0	'L'
+#define ANALIZADOR_CABECERA_1	'A'
+#define ANALIZADOR_MAX_REPETICIONES	255
+
+bool Analizador_Init(uint32_t relojSistema, uint32_t frecuencia, uint32_t pre, uint32_t post);
+void Analizador_Iniciar(void);
+bool Analizador_Terminado(void);
+void Analizador_Volcar(void (*enviar)(uint8_t dato));
+void Analizador_Timer0(void);
+void Int_GPIOF_Handler(void);
+
+#endif /* ANALIZADOR_H_ */
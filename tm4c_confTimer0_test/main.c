@@ -6,6 +6,9 @@
  *
  * Programa que configura el TIMER0 en modo periodico y hace toggle a un LED en el Launchpad
  *
+ * Con __ANALIZADOR_LOGICO__ el TIMER0 marca la frecuencia de muestreo de un analizador logico del
+ * puerto F (uDMA) que se dispara con SW1 (PF4) y envia la captura por UART0 a 115200.
+ *
  */
 
 #include <stdint.h>
@@ -18,28 +21,91 @@
 #include "driverlib/gpio.h"
 #include "driverlib/timer.h"
 #include "driverlib/interrupt.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/uart.h"
+#include "pin_gpio.h"
+#include "analizador.h"
+#include "reposo.h"
+
+// Reloj del sistema con el PLL a RELOJ_OBJETIVO (80MHz por defecto), define RELOJ_SISTEMA para los retardos
+#include "reloj.h"
+#include "retardo.h"
+#include "divisor.h"
+
+// 115200 baudios, divisor resuelto en tiempo de compilacion
+#define BAUD_UART	115200
+typedef char uart_divisorValido[UART_DIVISOR_VALIDO(RELOJ_SISTEMA, BAUD_UART)];
+
+// Descomentar para usar el TIMER0 como reloj de muestreo del analizador logico
+//#define __ANALIZADOR_LOGICO__
+#define ANALIZADOR_FRECUENCIA	1000000		// muestras por segundo
+#define ANALIZADOR_PRE			512			// muestras antes del disparo
+#define ANALIZADOR_POST			1024		// muestras despues del disparo
 
 // Prototipos de funciones
 void ConfigurarTimer(uint32_t load);
 void ConfigurarLEDs(void);
 
 // Definiciones
-#define PF3	HWREG(GPIO_PORTF_BASE + 32)
+DEFINIR_PIN(PF3, GPIO_PUERTO_F, GPIO_PIN_3)
+DEFINIR_PIN(LEDS, GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3)
+
+// Variables globales
+t_estadisticasReposo reposo;		// residencia en sleep
+
+#ifdef __ANALIZADOR_LOGICO__
+static void ConfigurarUART(void);
+static void UART_Enviar(uint8_t dato);
+#endif
 
 int main(void) {
-	// Configurar el reloj a 40MHz
-	SysCtlClockSet(SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ | SYSCTL_USE_PLL | SYSCTL_SYSDIV_5);
+#ifdef __ANALIZADOR_LOGICO__
+	uint32_t patron = 0;
+#endif
+
+	// Configurar el reloj a RELOJ_SISTEMA
+	Reloj_Init();
 
 	// Configurar LED para hacer toggle
 	ConfigurarLEDs();
-	// Configurar el TIMER0 para 1s@40MHz
-	ConfigurarTimer(40000000);
+
+#ifdef __ANALIZADOR_LOGICO__
+	// Botones con pull-up como entradas del analizador, PF4 tambien es el disparo
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_LOCK) = GPIO_LOCK_KEY;	// Desbloquear PF0
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_CR) = 0x1f;
+	GPIOPinTypeGPIOInput(GPIO_PUERTO_F, GPIO_PIN_0 | GPIO_PIN_4);
+	GPIOPadConfigSet(GPIO_PUERTO_F, GPIO_PIN_0 | GPIO_PIN_4, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
+	ConfigurarUART();
+
+	Analizador_Init(Reloj_Frecuencia(), ANALIZADOR_FRECUENCIA, ANALIZADOR_PRE, ANALIZADOR_POST);
+	IntMasterEnable();
+
+	while (1) {
+		// Capturar hasta el disparo con un patron de prueba en los LEDs
+		Analizador_Iniciar();
+		while (!Analizador_Terminado()) {
+			LEDS_Escribir(++patron << 1);
+			RETARDO_US(8);
+		}
+		LEDS_Bajo();
+		Analizador_Volcar(UART_Enviar);
+	}
+#endif
+	// Configurar el TIMER0 para 1s
+	ConfigurarTimer(CICLOS_US(1000000));
+	// Perifericos que siguen con reloj mientras el nucleo duerme
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOF);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_TIMER0);
+	Reposo_Init(TIMER0_BASE);
 	// Habilitar las interrupciones globales
 	IntMasterEnable();
 
 	// Ciclo principal
 	while (1) {
-		// Esperar las interrupciones
+		// Dormir hasta las interrupciones
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
 	}
 }
 
@@ -49,11 +115,12 @@ int main(void) {
 void ConfigurarLEDs(void) {
 	// Habilitar reloj al periferico
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
 	// Configurar como salida
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_3);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_3);
 	// Apagar el LED
-	//GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_3, 0x00);
-	PF3 = 0;
+	//GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_3, 0x00);
+	PF3_Bajo();
 }
 
 /*
@@ -77,10 +144,33 @@ void ConfigurarTimer(uint32_t load) {
 /*
  * Rutina de interrupcion de TIMER0 periodico
  */
-void Int_Timer0_Handler(void) {
+void Int_Timer0A_Handler(void) {
+#ifdef __ANALIZADOR_LOGICO__
+	// Fin de un bloque del uDMA
+	Analizador_Timer0();
+#else
 	// Borrar la interrupcion
 	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
 
 	// Hacer toggle al LED
-	PF3 ^= 0xff;
+	PF3_Conmutar();
+#endif
+}
+
+#ifdef __ANALIZADOR_LOGICO__
+/*
+ * Configura UART0 (puerto virtual) como 8N1@115200 para el volcado del analizador
+ */
+static void ConfigurarUART(void) {
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+	GPIOPinConfigure(GPIO_PA0_U0RX);
+	GPIOPinConfigure(GPIO_PA1_U0TX);
+	GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+	Divisor_UART(UART0_BASE, UART_DIVISOR(RELOJ_SISTEMA, BAUD_UART), UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+}
+
+static void UART_Enviar(uint8_t dato) {
+	UARTCharPut(UART0_BASE, dato);
 }
+#endif
@@ -17,10 +17,20 @@
 // headers para utilizar interrupciones de uart
 #include "inc/hw_ints.h"
 #include "driverlib/interrupt.h"
+#include "pin_gpio.h"
+
+// Reloj del sistema con el PLL a RELOJ_OBJETIVO (80MHz por defecto), define RELOJ_SISTEMA para los retardos
+#include "reloj.h"
+#include "retardo.h"
+#include "divisor.h"
+
+// 9600 baudios, divisor resuelto en tiempo de compilacion
+#define BAUD_UART	9600
+typedef char uart_divisorValido[UART_DIVISOR_VALIDO(RELOJ_SISTEMA, BAUD_UART)];
 
 // leds para status
-#define PF1		HWREG(GPIO_PORTF_BASE + 0x08)
-#define PF2		HWREG(GPIO_PORTF_BASE + 0x10)
+DEFINIR_PIN(PF1, GPIO_PUERTO_F, GPIO_PIN_1)
+DEFINIR_PIN(PF2, GPIO_PUERTO_F, GPIO_PIN_2)
 
 /*
  * Configura los leds en PF1 y PF2 para mostrar status
@@ -28,18 +38,19 @@
 void confLeds(void) {
 	// Reloj al puerto F
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
 	// Poner como salidas
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2);
 	// Apagar inicialmente
-	GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2, 0xff);
+	GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2, 0xff);
 }
 
 /*
  * Programa principal
  */
 int main(void) {
-	// Configuracion de reloj a 40MHz
-	SysCtlClockSet(SYSCTL_OSC_MAIN | SYSCTL_USE_PLL | SYSCTL_SYSDIV_5 | SYSCTL_XTAL_16MHZ);
+	// Configuracion de reloj a RELOJ_SISTEMA
+	Reloj_Init();
 
 	// Habilitacion de perifericos
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
@@ -47,7 +58,7 @@ int main(void) {
 
 	// Configuracion de LEDs para status
 	confLeds();
-	PF2 = 0xf; // status
+	PF2_Alto(); // status
 
 	// Configuracion de pines UART
 	GPIOPinConfigure(GPIO_PA0_U0RX);
@@ -55,7 +66,7 @@ int main(void) {
 	GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
 
 	// Configuracion del periferico
-	UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 9600, UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+	Divisor_UART(UART0_BASE, UART_DIVISOR(RELOJ_SISTEMA, BAUD_UART), UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
 
 	// Configuracion de interrupciones, de recepcion de receive-timeout
 	UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
@@ -81,7 +92,7 @@ int main(void) {
 	}
 }
 
-void UART0_IntHandler(void) {
+void Int_UART0_Handler(void) {
 	// obtener el status de la interrupcion
 	uint32_t status;
 	status = UARTIntStatus(UART0_BASE, true);
@@ -93,8 +104,8 @@ void UART0_IntHandler(void) {
 		// echo
 		UARTCharPutNonBlocking(UART0_BASE, UARTCharGetNonBlocking(UART0_BASE));
 		// hacer blinking al led 1ms
-		PF1 = 1 << 1;
-		SysCtlDelay(40000);  // para 1ms
-		PF1 = 0 << 1;
+		PF1_Alto();
+		RETARDO_MS(1);
+		PF1_Bajo();
 	}
 }
@@ -0,0 +1,127 @@
+/*
+ * dac_traza.c
+ *
+ * Programa para la PC que manda formas de onda al modelo SSI0 + TLV5616 con la misma trama que
+ * DAC_Out/DAC_OutBlock (tm4c_confSSI_test) y guarda la salida del DAC en un archivo de traza.
+ * Reemplaza la medicion manual de voltajes de datosMedidos.xlsx.
+ *
+ * 	dac_traza [reloj_hz] [traza.csv] [muestras_por_segundo]
+ *
+ * Pruebas:
+ * 	1. Rampa de 4096 codigos enviada sin pausa, mide palabras/segundo
+ * 	2. Seno de 256 puntos a una tasa fija (como desde un timer), mide jitter, errores de codigo
+ * 	   y actualizaciones que llegan antes de que la salida se establezca
+ * 	3. Control: la misma rampa con tramas de 8 bits tiene que dar errores
+ *
+ * Un error de codigo es una trama que no produce exactamente una actualizacion del TLV5616 con
+ * el codigo, la velocidad y la potencia que se querian enviar, decodificados de los bits que
+ * desplazo el SSI. Todas las tramas usan el modo del firmware (DAC_SPD_SLOW + DAC_PWR_NORMAL).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "ssi0_tlv5616.h"
+#include "../tm4c_confSSI_test/ssi_clock.h"
+#include "../tm4c_confSSI_test/tlv5616.h"
+
+// Ciclos del CPU por palabra escrita en la FIFO (carga, mascara, store y lazo)
+#define CICLOS_PALABRA	8
+#define RAMPA_PALABRAS	4096
+#define SENO_PUNTOS		256
+#define SENO_PERIODOS	4
+#define VREF			2.048
+#define BITS_TRAMA		16			// SSI_CR0_DSS_16 en SSI0_Init
+#define MODO_DAC		(DAC_SPD_SLOW + DAC_PWR_NORMAL)		// como DAC_Out y DAC_OutBlock
+
+/*
+ * Envia la trama y revisa que el TLV5616 la haya recibido completa y decodificado igual
+ */
+static uint64_t EnviarVerificado(t_SSI0Sim *sim, uint64_t ciclo, uint16_t codigo, uint32_t *errores) {
+	uint32_t antes = sim->actualizaciones;
+	uint64_t aceptado;
+
+	aceptado = SSI0Sim_Put(sim, ciclo, DAC_TRAMA(codigo, MODO_DAC));
+	if (sim->actualizaciones != antes + 1 || sim->ultimoCodigo != codigo ||
+			sim->ultimoRapido != ((MODO_DAC & DAC_SPD_FAST) != 0) ||
+			sim->ultimoApagado != ((MODO_DAC & DAC_PWR_DOWN) != 0)) {
+		(*errores)++;
+	}
+	return aceptado;
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t reloj = 40000000, tasa = 40000;
+	const char *archivo = "dac_traza.csv";
+	t_planSSI plan;
+	t_SSI0Sim sim;
+	FILE *traza;
+	uint64_t ciclo, ideal, latencia = 0, periodo, anterior = 0;
+	double jitter, jitterMax = 0.0, palabrasSeg;
+	uint32_t i, errores = 0, erroresControl = 0, sinEstablecer = 0;
+	t_SSI0Sim control;
+	uint16_t codigo;
+
+	if (argc > 1) reloj = strtoul(argv[1], NULL, 10);
+	if (argc > 2) archivo = argv[2];
+	if (argc > 3) tasa = strtoul(argv[3], NULL, 10);
+
+	if (!SSI_PlanReloj(reloj, &plan)) {
+		fprintf(stderr, "No hay configuracion de SSI valida para %lu Hz\n", (unsigned long)reloj);
+		return 1;
+	}
+	traza = fopen(archivo, "w");
+	if (!traza) {
+		perror(archivo);
+		return 1;
+	}
+	SSI0Sim_Init(&sim, reloj, &plan, BITS_TRAMA, VREF, traza);
+	printf("Reloj %lu Hz, CPSDVSR %u, SCR %u, SSIClk %lu Hz\n", (unsigned long)reloj, plan.cpsdvsr,
+			plan.scr, (unsigned long)plan.bitRate);
+
+	// 1. Rampa sin pausa
+	ciclo = 0;
+	for (i = 0; i < RAMPA_PALABRAS; i++) {
+		codigo = i & DAC_CODIGO_M;
+		ciclo = EnviarVerificado(&sim, ciclo, codigo, &errores) + CICLOS_PALABRA;
+	}
+	palabrasSeg = (RAMPA_PALABRAS - 1) * 1e9 /
+			(SSI0Sim_Ns(&sim, sim.ultimaActualizacion) - SSI0Sim_Ns(&sim, sim.primeraActualizacion));
+	printf("Rampa: %u palabras, %.0f palabras/s, CPU esperando la FIFO %.1f%%\n", RAMPA_PALABRAS,
+			palabrasSeg, 100.0 * sim.ciclosEspera / SSI0Sim_Idle(&sim));
+
+	// 2. Seno a tasa fija, empezando con la linea libre
+	periodo = reloj / tasa;
+	ciclo = SSI0Sim_Idle(&sim) + periodo;
+	for (i = 0; i < SENO_PUNTOS * SENO_PERIODOS; i++) {
+		codigo = (uint16_t)(2047.5 + 2047.5 * sin(2.0 * M_PI * i / SENO_PUNTOS));
+		ideal = ciclo + i * periodo;
+		EnviarVerificado(&sim, ideal, codigo, &errores);
+
+		// La latencia de la primera muestra es la referencia, el jitter es la variacion respecto a ella
+		if (i == 0) latencia = sim.ultimaActualizacion - ideal;
+		jitter = fabs(SSI0Sim_Ns(&sim, sim.ultimaActualizacion - ideal) - SSI0Sim_Ns(&sim, latencia));
+		if (jitter > jitterMax) jitterMax = jitter;
+		if (i > 0 && SSI0Sim_Ns(&sim, sim.ultimaActualizacion - anterior) < TLV5616_TS_SLOW_NS) sinEstablecer++;
+		anterior = sim.ultimaActualizacion;
+	}
+	printf("Seno: %u muestras a %lu S/s, latencia %.1f ns, jitter maximo %.1f ns, sin establecer %u\n",
+			SENO_PUNTOS * SENO_PERIODOS, (unsigned long)tasa, SSI0Sim_Ns(&sim, latencia), jitterMax, sinEstablecer);
+
+	printf("Tramas %u, actualizaciones %u, errores de codigo %u, traza en %s\n", sim.tramas,
+			sim.actualizaciones, errores, archivo);
+
+	// 3. Control: con tramas de 8 bits la verificacion tiene que fallar
+	SSI0Sim_Init(&control, reloj, &plan, 8, VREF, NULL);
+	ciclo = 0;
+	for (i = 0; i < RAMPA_PALABRAS; i++) {
+		ciclo = EnviarVerificado(&control, ciclo, i & DAC_CODIGO_M, &erroresControl) + CICLOS_PALABRA;
+	}
+	printf("Control con tramas de 8 bits: %u errores de %u tramas%s\n", erroresControl, control.tramas,
+			erroresControl ? "" : " (la verificacion no detecta errores de formato)");
+
+	fclose(traza);
+	return (errores || erroresControl == 0) ? 1 : 0;
+}
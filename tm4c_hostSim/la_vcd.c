@@ -0,0 +1,106 @@
+/*
+ * la_vcd.c
+ *
+ * Programa para la PC que convierte el volcado del analizador logico (tm4c_confTimer0_test con
+ * __ANALIZADOR_LOGICO__, capturado del puerto serie a un archivo) en un archivo VCD para verlo en
+ * GTKWave u otro visor de formas de onda. El disparo se marca con la senal "disparo".
+ *
+ * 	la_vcd captura.bin captura.vcd
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../tm4c_confTimer0_test/analizador.h"
+
+#define PINES	5		// PF0 a PF4
+
+static int leerByte(FILE *f) {
+	int c = fgetc(f);
+	if (c == EOF) {
+		fprintf(stderr, "volcado incompleto\n");
+	}
+	return c;
+}
+
+int main(int argc, char **argv) {
+	FILE *entrada, *salida;
+	uint32_t frecuencia = 0, muestras, disparo, n = 0, i;
+	int valor, repeticiones, anterior = -1, pin, c, disparoMarcado = 0;
+	double ns;
+
+	if (argc < 3) {
+		fprintf(stderr, "uso: la_vcd captura.bin captura.vcd\n");
+		return 1;
+	}
+	entrada = fopen(argv[1], "rb");
+	salida = fopen(argv[2], "w");
+	if (entrada == NULL || salida == NULL) {
+		perror("la_vcd");
+		return 1;
+	}
+
+	// Buscar la cabecera, el archivo puede tener basura de antes del volcado
+	do {
+		c = leerByte(entrada);
+		if (c == EOF) return 1;
+	} while (!(c == ANALIZADOR_CABECERA_0 && (c = leerByte(entrada)) == ANALIZADOR_CABECERA_1));
+
+	for (i = 0; i < 32; i += 8) {
+		frecuencia |= (uint32_t)leerByte(entrada) << i;
+	}
+	muestras = leerByte(entrada);
+	muestras |= leerByte(entrada) << 8;
+	disparo = leerByte(entrada);
+	disparo |= leerByte(entrada) << 8;
+	if (frecuencia == 0) {
+		fprintf(stderr, "frecuencia invalida\n");
+		return 1;
+	}
+	ns = 1e9 / frecuencia;
+
+	fprintf(salida, "$timescale 1ns $end\n$scope module puertoF $end\n");
+	for (pin = 0; pin < PINES; pin++) {
+		fprintf(salida, "$var wire 1 %c PF%d $end\n", '0' + pin, pin);
+	}
+	fprintf(salida, "$var wire 1 D disparo $end\n");
+	fprintf(salida, "$upscope $end\n$enddefinitions $end\n");
+
+	// Un cambio de valor por corrida, solo se escriben los pines que cambian
+	for (;;) {
+		valor = leerByte(entrada);
+		repeticiones = leerByte(entrada);
+		if (valor == EOF || repeticiones == EOF || repeticiones == 0) {
+			break;
+		}
+		if (valor != anterior) {
+			fprintf(salida, "#%lld\n", (long long)(n * ns));
+			for (pin = 0; pin < PINES; pin++) {
+				if (anterior < 0 || ((valor ^ anterior) >> pin) & 1) {
+					fprintf(salida, "%d%c\n", (valor >> pin) & 1, '0' + pin);
+				}
+			}
+			if (anterior < 0) {
+				fprintf(salida, "0D\n");
+			}
+			anterior = valor;
+		}
+		if (!disparoMarcado && disparo < n + repeticiones) {
+			if (disparo > n) {
+				fprintf(salida, "#%lld\n", (long long)(disparo * ns));
+			}
+			fprintf(salida, "1D\n");
+			disparoMarcado = 1;
+		}
+		n += repeticiones;
+	}
+	fprintf(salida, "#%lld\n", (long long)(n * ns));
+
+	printf("%u muestras a %u Hz, disparo en la muestra %u\n", n, frecuencia, disparo);
+	if (n != muestras) {
+		printf("aviso: la cabecera indica %u muestras\n", muestras);
+	}
+	fclose(entrada);
+	fclose(salida);
+	return 0;
+}
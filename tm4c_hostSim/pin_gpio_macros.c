@@ -0,0 +1,36 @@
+/*
+ * pin_gpio_macros.c
+ *
+ * Accesos a los pines del puerto F con los macros HWREG escritos a mano que usaban los proyectos
+ * antes de DEFINIR_PIN. Misma secuencia que pin_gpio_pines.c.
+ */
+
+#include <stdint.h>
+
+#include "../tm4c_common/pin_gpio.h"
+
+#define PF0		HWREG(GPIO_PORTF_BASE + 4)
+#define PF1		HWREG(GPIO_PORTF_BASE + 0x08)
+#define PF2		HWREG(GPIO_PORTF_BASE + 0x10)
+#define PF3		HWREG(GPIO_PORTF_BASE + 0x20)
+#define PF4		HWREG(GPIO_PORTF_BASE + 64)
+#define PF12	HWREG(GPIO_PORTF_BASE + 0x8 + 0x10)
+#define LEDS	HWREG(GPIO_PORTF_BASE + 0x08 + 0x10 + 0x20)
+
+uint32_t Secuencia_Macros(uint32_t valor) {
+	uint32_t sw1, sw2;
+
+	PF12 = 0xff;
+	PF12 = 0x00;
+	PF2 = 0xff;
+	PF2 ^= 0xff;
+	PF3 = 0;
+	PF3 ^= 0xff;
+	PF1 ^= 0xff;
+	sw1 = !PF4;
+	sw2 = !PF0;
+	PF2 = 0xf;
+	PF1 = 1 << 1;
+	LEDS = valor;
+	return (sw1 << 1) | sw2;
+}
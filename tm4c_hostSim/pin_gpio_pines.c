@@ -0,0 +1,36 @@
+/*
+ * pin_gpio_pines.c
+ *
+ * Accesos a los pines del puerto F de los proyectos escritos con DEFINIR_PIN (tm4c_common/pin_gpio.h).
+ * Misma secuencia que pin_gpio_macros.c, se compilan por separado para comparar el tamano de los objetos.
+ */
+
+#include <stdint.h>
+
+#include "../tm4c_common/pin_gpio.h"
+
+DEFINIR_PIN(PF0, GPIO_PUERTO_F, GPIO_PIN_0)
+DEFINIR_PIN(PF1, GPIO_PUERTO_F, GPIO_PIN_1)
+DEFINIR_PIN(PF2, GPIO_PUERTO_F, GPIO_PIN_2)
+DEFINIR_PIN(PF3, GPIO_PUERTO_F, GPIO_PIN_3)
+DEFINIR_PIN(PF4, GPIO_PUERTO_F, GPIO_PIN_4)
+DEFINIR_PIN(PF12, GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2)
+DEFINIR_PIN(LEDS, GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3)
+
+uint32_t Secuencia_Pines(uint32_t valor) {
+	uint32_t sw1, sw2;
+
+	PF12_Alto();
+	PF12_Bajo();
+	PF2_Alto();
+	PF2_Conmutar();
+	PF3_Bajo();
+	PF3_Conmutar();
+	PF1_Conmutar();
+	sw1 = !PF4_Leer();
+	sw2 = !PF0_Leer();
+	PF2_Escribir(0xf);
+	PF1_Escribir(1 << 1);
+	LEDS_Escribir(valor);
+	return (sw1 << 1) | sw2;
+}
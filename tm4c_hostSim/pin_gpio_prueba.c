@@ -0,0 +1,67 @@
+/*
+ * pin_gpio_prueba.c
+ *
+ * Programa para la PC que corre la misma secuencia de accesos a los pines del puerto F con DEFINIR_PIN
+ * (pin_gpio_pines.c) y con los macros HWREG escritos a mano (pin_gpio_macros.c) sobre un bloque de
+ * registros simulado (GPIO_HOST), y verifica que las dos hacen el mismo numero de accesos, leen lo
+ * mismo y dejan los registros iguales.
+ *
+ * 	pin_gpio_prueba
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../tm4c_common/pin_gpio.h"
+
+uint32_t Secuencia_Pines(uint32_t valor);
+uint32_t Secuencia_Macros(uint32_t valor);
+
+volatile uint32_t gpioHostBloque[GPIO_HOST_PALABRAS];
+uint32_t gpioHostAccesos;
+
+// Estado de los registros despues de la secuencia con DEFINIR_PIN
+static uint32_t copia[GPIO_HOST_PALABRAS];
+
+// Llena el bloque con un patron (todo en 0 con semilla 0) para probar las dos lecturas de los botones
+static void Sembrar(uint32_t semilla) {
+	uint32_t i;
+
+	for (i = 0; i < GPIO_HOST_PALABRAS; i++) {
+		gpioHostBloque[i] = semilla * (i + 1) * 2654435761u;
+	}
+}
+
+int main(void) {
+	uint32_t valor, i, errores = 0, diferentes;
+	uint32_t accesosPines, accesosMacros, lecturaPines, lecturaMacros;
+
+	printf("valor  accesos_pin  accesos_hwreg  lectura_pin  lectura_hwreg  registros_distintos\n");
+	for (valor = 0; valor < 16; valor += 5) {
+		Sembrar(valor);
+		gpioHostAccesos = 0;
+		lecturaPines = Secuencia_Pines(valor << 1);
+		accesosPines = gpioHostAccesos;
+		for (i = 0; i < GPIO_HOST_PALABRAS; i++) {
+			copia[i] = gpioHostBloque[i];
+		}
+
+		Sembrar(valor);
+		gpioHostAccesos = 0;
+		lecturaMacros = Secuencia_Macros(valor << 1);
+		accesosMacros = gpioHostAccesos;
+		diferentes = 0;
+		for (i = 0; i < GPIO_HOST_PALABRAS; i++) {
+			diferentes += (copia[i] != gpioHostBloque[i]);
+		}
+
+		printf("%5u  %11u  %13u  %11u  %13u  %19u\n", valor << 1, accesosPines, accesosMacros,
+				lecturaPines, lecturaMacros, diferentes);
+		if (accesosPines != accesosMacros || lecturaPines != lecturaMacros || diferentes) {
+			errores++;
+		}
+	}
+
+	printf("%s\n", errores ? "FALLA" : "OK");
+	return errores ? 1 : 0;
+}
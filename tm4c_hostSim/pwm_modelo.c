@@ -0,0 +1,117 @@
+/*
+ * pwm_modelo.c
+ *
+ * Modelo para la PC de un generador PWM en modo descendente, ver pwm_modelo.h
+ */
+
+#include "pwm_modelo.h"
+
+/*
+ * Ancho del pulso en ticks que produce un valor de comparacion
+ */
+static uint32_t PWMModelo_Ancho(const t_pwmModelo *m, uint32_t cmpa) {
+	return (m->acciones == PWM_BAJO_EN_CARGA) ? cmpa + 1 : m->carga - cmpa;
+}
+
+/*
+ * Cambia la salida y registra los flancos
+ */
+static void PWMModelo_Salida(t_pwmModelo *m, bool valor) {
+	uint32_t ancho;
+
+	if (valor && !m->salida) {
+		m->inicioPulso = m->tick;
+		m->cmpaInicioPulso = m->cmpa;
+		m->flancosPeriodo++;
+	} else if (!valor && m->salida) {
+		// El pulso es valido si su ancho corresponde al comparador al inicio o al final del pulso
+		ancho = (uint32_t)(m->tick - m->inicioPulso);
+		m->pulsos++;
+		if (ancho != PWMModelo_Ancho(m, m->cmpaInicioPulso) && ancho != PWMModelo_Ancho(m, m->cmpa)) {
+			m->anchoInvalido++;
+		}
+	}
+	m->salida = valor;
+}
+
+/*
+ * Inicializa el generador con el contador en cero, el primer ciclo es un evento de carga
+ */
+void PWMModelo_Init(t_pwmModelo *m, uint32_t carga, uint32_t cmpa, t_modoPWM modo, t_accionesPWM acciones) {
+	m->modo = modo;
+	m->acciones = acciones;
+	m->carga = carga;
+	m->contador = 0;
+	m->cmpa = cmpa;
+	m->cmpaPendiente = cmpa;
+	m->pendiente = false;
+	m->syncGlobal = false;
+	m->salida = false;
+	m->tick = 0;
+	m->inicioPulso = 0;
+	m->cmpaInicioPulso = cmpa;
+	m->flancosPeriodo = 0;
+	m->periodos = 0;
+	m->pulsos = 0;
+	m->anchoInvalido = 0;
+	m->dobles = 0;
+	m->faltantes = 0;
+}
+
+/*
+ * Escritura al registro PWMnCMPA
+ */
+void PWMModelo_EscribirCMPA(t_pwmModelo *m, uint32_t valor) {
+	if (m->modo == PWM_INMEDIATO) {
+		m->cmpa = valor;
+	} else {
+		m->cmpaPendiente = valor;
+		m->pendiente = true;
+	}
+}
+
+/*
+ * Escritura del bit GLOBALSYNC del generador en PWMCTL
+ */
+void PWMModelo_SyncGlobal(t_pwmModelo *m) {
+	m->syncGlobal = true;
+}
+
+/*
+ * Avanza un ciclo del reloj PWM. Devuelve true en el evento de carga (inicio de periodo),
+ * donde el programa atenderia la interrupcion INTCNTLOAD.
+ */
+bool PWMModelo_Tick(t_pwmModelo *m) {
+	bool carga = false;
+
+	m->tick++;
+	if (m->contador == 0) {
+		// Cero: se aplican las escrituras sincronizadas y se recarga el contador
+		if (m->pendiente && (m->modo == PWM_LOCAL || m->syncGlobal)) {
+			m->cmpa = m->cmpaPendiente;
+			m->pendiente = false;
+			m->syncGlobal = false;
+		}
+		// Revisar los pulsos del periodo que termina (el primer cero solo arranca el contador)
+		if (m->tick > 1) {
+			m->periodos++;
+			if (m->flancosPeriodo > 1) {
+				m->dobles++;
+			} else if (m->flancosPeriodo == 0) {
+				m->faltantes++;
+			}
+		}
+		m->flancosPeriodo = 0;
+
+		m->contador = m->carga;
+		PWMModelo_Salida(m, m->acciones == PWM_ALTO_EN_CARGA);
+		carga = true;
+	} else {
+		m->contador--;
+	}
+
+	if (m->contador == m->cmpa && !carga) {
+		PWMModelo_Salida(m, m->acciones == PWM_BAJO_EN_CARGA);
+	}
+	return carga;
+}
@@ -0,0 +1,66 @@
+/*
+ * pwm_modelo.h
+ *
+ * Modelo para la PC de un generador PWM del TM4C123 en modo descendente, ciclo por ciclo del reloj PWM.
+ * Modela el modo de actualizacion del comparador A (sincronizacion local o global) y las dos
+ * configuraciones de acciones usadas en tm4c_confPWM_test. Cuenta los pulsos con ancho que no
+ * corresponde a ningun valor del comparador (runt o alargado), periodos con dos pulsos y periodos sin pulso.
+ *
+ * El TM4C123 solo tiene esos dos modos: CMPAUPD = 0 (valor de reset, PWM_GEN_MODE_NO_SYNC en la
+ * libreria) ya aplica la escritura en el cero. PWM_INMEDIATO no es un modo del TM4C123, es la
+ * referencia hipotetica de un comparador sin sincronizacion para ver que evitan los otros dos.
+ */
+
+#ifndef PWM_MODELO_H_
+#define PWM_MODELO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Cuando se aplica una escritura a CMPA
+enum modoPWM {
+	PWM_INMEDIATO,		// en el siguiente ciclo, hipotetico: no existe en el TM4C123
+	PWM_LOCAL,			// cuando el contador llega a cero
+	PWM_GLOBAL			// en el siguiente cero despues de pedir la sincronizacion global
+};
+
+// Acciones del generador
+enum accionesPWM {
+	PWM_BAJO_EN_CARGA,	// ACTLOAD_ZERO | ACTCMPAD_ONE (PWM1_Init con registros), ancho = CMPA + 1
+	PWM_ALTO_EN_CARGA	// ACTLOAD_ONE | ACTCMPAD_ZERO (libreria), ancho = LOAD - CMPA
+};
+
+typedef enum modoPWM t_modoPWM;
+typedef enum accionesPWM t_accionesPWM;
+
+struct pwmModelo {
+	t_modoPWM modo;
+	t_accionesPWM acciones;
+	uint32_t carga;			// PWMnLOAD
+	uint32_t contador;
+	uint32_t cmpa;			// valor activo
+	uint32_t cmpaPendiente;
+	bool pendiente;
+	bool syncGlobal;
+	bool salida;
+	// Pulso actual
+	uint64_t tick;
+	uint64_t inicioPulso;
+	uint32_t cmpaInicioPulso;
+	uint32_t flancosPeriodo;
+	// Estadisticas
+	uint32_t periodos;
+	uint32_t pulsos;
+	uint32_t anchoInvalido;
+	uint32_t dobles;
+	uint32_t faltantes;
+};
+
+typedef struct pwmModelo t_pwmModelo;
+
+void PWMModelo_Init(t_pwmModelo *m, uint32_t carga, uint32_t cmpa, t_modoPWM modo, t_accionesPWM acciones);
+void PWMModelo_EscribirCMPA(t_pwmModelo *m, uint32_t valor);
+void PWMModelo_SyncGlobal(t_pwmModelo *m);
+bool PWMModelo_Tick(t_pwmModelo *m);
+
+#endif /* PWM_MODELO_H_ */
@@ -0,0 +1,103 @@
+/*
+ * pwm_pulsos.c
+ *
+ * Programa para la PC que cambia el ciclo de trabajo del modelo de PWM varias veces por periodo en
+ * instantes aleatorios, como PWM1_Duty llamado desde cualquier contexto, y cuenta pulsos invalidos
+ * para cada modo de actualizacion. Usa los valores de tm4c_confPWM_test (50000 ticks, 2500 a 6000).
+ *
+ * 	pwm_pulsos [periodos] [escrituras_por_periodo]
+ *
+ * Modos:
+ * 	directo		referencia hipotetica, comparador sin sincronizacion (no existe en el TM4C123)
+ * 	local		sincronizacion local, aplica al llegar a cero
+ * 	global		sincronizacion global pedida despues de cada escritura
+ *
+ * El PWM1_Duty original (CMPAUPD = 0) ya estaba sincronizado localmente, como el modo local: en el
+ * TM4C123 no puede producir pulsos invalidos. El renglon directo no entra en el resultado.
+ *
+ * La latencia de una escritura (hasta que el comparador toma el valor) se mide con una sonda de
+ * tm4c_common/perfil.c sobre la cuenta de ciclos del modelo.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "pwm_modelo.h"
+
+#define __PERFIL__
+#include "../tm4c_common/perfil.h"
+
+#define PERIODO_PWM	50000
+#define MIN			2500
+#define MAX			6000
+#define MIDPOINT	4250
+
+// Valor de CMPA para 1.5ms con cada configuracion de acciones
+#define MIDPOINT_CMPA(acciones)	((acciones) == PWM_BAJO_EN_CARGA ? MIDPOINT - 1 : PERIODO_PWM - 1 - MIDPOINT)
+
+// Modos de prueba
+#define MODOS	3
+static const char *nombres[MODOS] = {"directo", "local", "global"};
+static const t_modoPWM modos[MODOS] = {PWM_INMEDIATO, PWM_LOCAL, PWM_GLOBAL};
+
+// Ciclos PWM desde cada escritura hasta que el comparador tiene ese valor (sin las reemplazadas)
+PERFIL_SONDA(latencia);
+
+int main(int argc, char *argv[]) {
+	uint32_t periodos = 2000, escrituras = 4;
+	uint32_t a, i, errores = 0, duty;
+	uint64_t proxima;
+	uint32_t medido = 0;
+	bool midiendo;
+	t_pwmModelo m;
+	t_accionesPWM acciones;
+
+	if (argc > 1) periodos = strtoul(argv[1], NULL, 10);
+	if (argc > 2) escrituras = strtoul(argv[2], NULL, 10);
+
+	printf("%u periodos, %u escrituras por periodo en promedio\n", periodos, escrituras);
+	printf("acciones         modo     pulsos  invalidos  dobles  faltantes  aplicadas  latencia_max  latencia_media\n");
+	Perfil_Init();
+	for (a = 0; a < 2; a++) {
+		acciones = a ? PWM_ALTO_EN_CARGA : PWM_BAJO_EN_CARGA;
+		for (i = 0; i < MODOS; i++) {
+			srand(1234);
+			PWMModelo_Init(&m, PERIODO_PWM - 1, MIDPOINT_CMPA(acciones), modos[i], acciones);
+			proxima = (uint32_t)rand() % (2 * PERIODO_PWM / escrituras);
+			Perfil_Reiniciar();
+			midiendo = false;
+			while (m.periodos < periodos) {
+				PWMModelo_Tick(&m);
+				perfilCiclosHost = (uint32_t)m.tick;
+				if (midiendo && m.cmpa == medido) {
+					PERFIL_FIN(latencia);
+					midiendo = false;
+				}
+				// Escritura en un instante aleatorio, separadas en promedio PERIODO_PWM / escrituras
+				if (m.tick >= proxima) {
+					proxima = m.tick + 1 + (uint32_t)rand() % (2 * PERIODO_PWM / escrituras);
+					duty = MIN + (uint32_t)rand() % (MAX - MIN);
+					duty = (acciones == PWM_BAJO_EN_CARGA) ? duty - 1 : PERIODO_PWM - 1 - duty;
+					PERFIL_INICIO(latencia);
+					medido = duty;
+					midiendo = true;
+					PWMModelo_EscribirCMPA(&m, duty);
+					if (modos[i] == PWM_GLOBAL) {
+						PWMModelo_SyncGlobal(&m);
+					}
+				}
+			}
+			printf("%-15s  %-7s  %6u  %9u  %6u  %9u  %9u  %12u  %14u\n", a ? "alto en carga" : "bajo en carga", nombres[i],
+					m.pulsos, m.anchoInvalido, m.dobles, m.faltantes, latencia.n, latencia.max,
+					latencia.n ? (uint32_t)(latencia.suma / latencia.n) : 0);
+			// Los modos sincronizados no deben producir ningun pulso invalido
+			if (modos[i] != PWM_INMEDIATO) {
+				errores += m.anchoInvalido + m.dobles + m.faltantes;
+			}
+		}
+	}
+
+	printf("%s\n", errores ? "FALLA" : "OK");
+	return errores ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * rueda_prueba.c
+ *
+ * Programa para la PC que corre la rueda de temporizadores de tm4c_common/rueda.c (RUEDA_HOST) con
+ * miles de temporizadores periodicos y de un solo disparo, con retardos y periodos mayores y menores
+ * que RUEDA_RANURAS, y verifica que cada llamada llega en el tick exacto.
+ *
+ * 	rueda_prueba [temporizadores] [ticks]
+ *
+ * Pruebas, con temporizadores al azar:
+ * 	- Un tercio se cancela a mitad de la corrida desde el programa principal
+ * 	- Un decimo se reinicia a si mismo desde su funcion con otro retardo
+ * 	- Rueda_Proximo se compara con el vencimiento mas cercano buscado uno por uno
+ * 	- Las interrupciones quedan habilitadas despues de cada Rueda_Iniciar/Rueda_Cancelar
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../tm4c_common/rueda.h"
+
+#define MAX_TEMPORIZADORES	20000
+#define MAX_RETARDO			(4 * RUEDA_RANURAS)
+
+struct prueba {
+	t_temporizador t;
+	uint32_t esperado;		// tick de la proxima llamada, 0 si no debe llamarse mas
+	uint32_t periodo;
+	uint32_t llamadas;
+	bool reinicia;
+};
+
+typedef struct prueba t_prueba;
+
+static t_prueba pruebas[MAX_TEMPORIZADORES];
+static uint32_t errores = 0;
+
+static uint32_t Azar(uint32_t max) {
+	return 1 + (uint32_t)rand() % max;
+}
+
+static void Funcion(void *arg) {
+	t_prueba *p = arg;
+	uint32_t ahora = Rueda_Ahora();
+
+	p->llamadas++;
+	if (ahora != p->esperado) {
+		if (errores < 10) {
+			printf("temporizador %u: llamado en %u, se esperaba %u\n", (uint32_t)(p - pruebas), ahora, p->esperado);
+		}
+		errores++;
+	}
+	if (p->reinicia) {
+		// Reinicio desde la propia funcion con otro retardo, siempre como un solo disparo
+		p->periodo = 0;
+		p->esperado = ahora + Azar(MAX_RETARDO);
+		Rueda_Iniciar(&p->t, p->esperado - ahora, 0, Funcion, p);
+	} else if (p->periodo) {
+		p->esperado += p->periodo;
+	} else {
+		p->esperado = 0;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t cantidad = 5000, ticks = 20000;
+	uint32_t i, k, retardo, minimo, proximo, errProximo = 0, errActivo = 0, errIrq = 0, totalLlamadas = 0;
+
+	if (argc > 1) cantidad = strtoul(argv[1], NULL, 10);
+	if (argc > 2) ticks = strtoul(argv[2], NULL, 10);
+	if (cantidad > MAX_TEMPORIZADORES) cantidad = MAX_TEMPORIZADORES;
+
+	srand(1234);
+	Rueda_Init();
+	for (i = 0; i < cantidad; i++) {
+		retardo = Azar(MAX_RETARDO);
+		pruebas[i].periodo = (i % 4 == 3) ? 0 : Azar(MAX_RETARDO);
+		pruebas[i].reinicia = (i % 10 == 9);
+		pruebas[i].esperado = retardo;
+		Rueda_Iniciar(&pruebas[i].t, retardo, pruebas[i].periodo, Funcion, &pruebas[i]);
+		errIrq += ruedaHostDeshabilitadas;
+	}
+
+	for (k = 1; k <= ticks; k++) {
+		if (k == ticks / 2) {
+			for (i = 0; i < cantidad; i += 3) {
+				Rueda_Cancelar(&pruebas[i].t);
+				pruebas[i].esperado = 0;
+				errIrq += ruedaHostDeshabilitadas;
+			}
+		}
+
+		// Vencimiento mas cercano (limitado a una vuelta como Rueda_Proximo)
+		if (k % 97 == 0) {
+			minimo = RUEDA_RANURAS;
+			for (i = 0; i < cantidad; i++) {
+				if (pruebas[i].esperado && pruebas[i].esperado - Rueda_Ahora() < minimo) {
+					minimo = pruebas[i].esperado - Rueda_Ahora();
+				}
+			}
+			proximo = Rueda_Proximo();
+			if (proximo != minimo) {
+				errProximo++;
+			}
+		}
+
+		Rueda_Tick();
+	}
+
+	// Llamadas que faltaron: temporizadores que debian vencer y siguen esperando un tick pasado
+	for (i = 0; i < cantidad; i++) {
+		totalLlamadas += pruebas[i].llamadas;
+		if (pruebas[i].esperado && pruebas[i].esperado <= ticks) {
+			errores++;
+		}
+		if (Rueda_Activo(&pruebas[i].t) != (pruebas[i].esperado != 0)) {
+			errActivo++;
+		}
+	}
+
+	printf("%u temporizadores, %u ticks, %u llamadas\n", cantidad, ticks, totalLlamadas);
+	printf("llamadas fuera de tiempo o faltantes: %u\n", errores);
+	printf("Rueda_Proximo distinto: %u\n", errProximo);
+	printf("Rueda_Activo distinto: %u\n", errActivo);
+	printf("interrupciones deshabilitadas al salir: %u\n", errIrq);
+	errores += errProximo + errActivo + errIrq;
+	printf("%s\n", errores ? "FALLA" : "OK");
+	return errores ? 1 : 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * servo_perfil.c
+ *
+ * Programa para la PC que corre el perfil trapezoidal de tm4c_confPWM_test/servo.c con los valores
+ * del proyecto (40MHz / 16: MIN 2500, MAX 6000, VEL_MAX 200, ACEL 50) y con movimientos al azar, y
+ * verifica en cada periodo:
+ * 	- la rapidez no pasa de velMax
+ * 	- el cambio de velocidad no pasa de acel, salvo el ultimo paso que se recorta en el objetivo
+ * 	- la posicion queda dentro de MIN y MAX, y el objetivo se limita a ese rango
+ * 	- desde reposo llega al objetivo sin pasarse y queda en reposo
+ * 	- Servo_Detener frena dentro de los limites y se detiene en el objetivo que calcula
+ *
+ * 	servo_perfil [movimientos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../tm4c_confPWM_test/servo.h"
+
+#define MIN			2500
+#define MAX			6000
+#define MIDPOINT	4250
+#define VEL_MAX		200
+#define ACEL		50
+
+// Limite de periodos para llegar al objetivo antes de considerarlo un error
+#define MAX_PASOS	10000
+
+static uint32_t errVelocidad = 0, errAcel = 0, errRango = 0, errPasado = 0, errLlegada = 0;
+
+static int32_t Absoluto(int32_t x) {
+	return (x >= 0) ? x : -x;
+}
+
+/*
+ * Avanza un periodo y revisa los limites de velocidad, aceleracion y rango
+ */
+static void Paso(t_perfilServo *p) {
+	int32_t velAnterior = p->velocidad;
+
+	Servo_PerfilPaso(p);
+	if (Absoluto(p->velocidad) > p->velMax) {
+		errVelocidad++;
+	}
+	// El ultimo paso se recorta para no pasarse, y el siguiente deja la velocidad en 0
+	if (Absoluto(p->velocidad - velAnterior) > p->acel && p->posicion != p->objetivo) {
+		errAcel++;
+	}
+	if (p->posicion < p->min || p->posicion > p->max) {
+		errRango++;
+	}
+}
+
+/*
+ * Avanza hasta que el servo queda en reposo; desde reposo la posicion no debe pasar el objetivo
+ */
+static void Llegar(t_perfilServo *p, bool desdeReposo) {
+	int32_t dir = (p->objetivo >= p->posicion) ? 1 : -1;
+	uint32_t pasos = 0;
+
+	while (!Servo_EnReposo(p) && pasos < MAX_PASOS) {
+		Paso(p);
+		if (desdeReposo && dir * (p->posicion - p->objetivo) > 0) {
+			errPasado++;
+		}
+		pasos++;
+	}
+	if (!Servo_EnReposo(p)) {
+		errLlegada++;
+	}
+}
+
+/*
+ * Paso por paso de un movimiento completo de MIN a MAX, para ver la forma del trapecio
+ */
+static void Trapecio(void) {
+	t_perfilServo p;
+	uint32_t n = 0;
+
+	Servo_PerfilInit(&p, MIN, MIN, MAX, VEL_MAX, ACEL);
+	Servo_Objetivo(&p, MAX);
+	printf("MIN a MAX: periodo posicion velocidad\n");
+	while (!Servo_EnReposo(&p) && n < MAX_PASOS) {
+		Paso(&p);
+		printf("%4u %5d %4d\n", n++, p.posicion, p.velocidad);
+	}
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t movimientos = 5000, i, k, errObjetivo = 0, errDetener = 0, errores;
+	int32_t objetivo, parada;
+	t_perfilServo p;
+
+	if (argc > 1) movimientos = strtoul(argv[1], NULL, 10);
+
+	Trapecio();
+
+	srand(1234);
+	for (i = 0; i < movimientos; i++) {
+		// Valores del proyecto en la mitad de las pruebas, el resto con limites al azar
+		if (i & 1) {
+			Servo_PerfilInit(&p, MIDPOINT, MIN, MAX, 1 + rand() % 400, 1 + rand() % 100);
+		} else {
+			Servo_PerfilInit(&p, MIDPOINT, MIN, MAX, VEL_MAX, ACEL);
+		}
+
+		// Objetivos fuera del rango se limitan a MIN o MAX
+		objetivo = MIN - 2000 + rand() % (MAX - MIN + 4000);
+		Servo_Objetivo(&p, objetivo);
+		if (p.objetivo != (objetivo < MIN ? MIN : objetivo > MAX ? MAX : objetivo)) {
+			errObjetivo++;
+		}
+		Llegar(&p, true);
+
+		// Cambio de objetivo a mitad del movimiento, muchas veces en sentido contrario
+		Servo_Objetivo(&p, MIN + rand() % (MAX - MIN + 1));
+		for (k = rand() % 20; k > 0 && !Servo_EnReposo(&p); k--) {
+			Paso(&p);
+		}
+		Servo_Objetivo(&p, MIN + rand() % (MAX - MIN + 1));
+		for (k = rand() % 20; k > 0 && !Servo_EnReposo(&p); k--) {
+			Paso(&p);
+		}
+
+		// Detener en movimiento: el objetivo nuevo se alcanza frenando
+		Servo_Detener(&p);
+		parada = p.objetivo;
+		Llegar(&p, false);
+		if (p.posicion != parada) {
+			errDetener++;
+		}
+	}
+
+	printf("%u movimientos\n", movimientos);
+	printf("rapidez sobre velMax: %u\n", errVelocidad);
+	printf("cambio de velocidad sobre acel: %u\n", errAcel);
+	printf("posicion fuera de MIN..MAX: %u\n", errRango);
+	printf("objetivo sin limitar: %u\n", errObjetivo);
+	printf("se paso del objetivo: %u\n", errPasado);
+	printf("no llego al reposo: %u\n", errLlegada);
+	printf("no se detuvo en el objetivo de Servo_Detener: %u\n", errDetener);
+	errores = errVelocidad + errAcel + errRango + errObjetivo + errPasado + errLlegada + errDetener;
+	printf("%s\n", errores ? "FALLA" : "OK");
+	return errores ? 1 : 0;
+}
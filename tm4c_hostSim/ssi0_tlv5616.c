@@ -0,0 +1,120 @@
+/*
+ * ssi0_tlv5616.c
+ *
+ * Modelo para la PC de SSI0 + TLV5616, ver ssi0_tlv5616.h
+ */
+
+#include "ssi0_tlv5616.h"
+#include "../tm4c_confSSI_test/tlv5616.h"
+
+/*
+ * Inicializa el modelo con la configuracion de reloj que calcula SSI_PlanReloj y el largo de
+ * trama del SSI (16 en tm4c_confSSI_test, SSI_CR0_DSS_16)
+ */
+void SSI0Sim_Init(t_SSI0Sim *sim, uint32_t relojSistema, const t_planSSI *plan, uint32_t bits, double vref, FILE *traza) {
+	uint32_t i;
+
+	sim->relojSistema = relojSistema;
+	sim->cicloBit = (uint32_t)plan->cpsdvsr * (1 + plan->scr);
+	for (i = 0; i < SSI_FIFO_PALABRAS; i++) {
+		sim->inicio[i] = 0;
+	}
+	sim->finUltima = 0;
+	sim->ciclosEspera = 0;
+	sim->primeraActualizacion = 0;
+	sim->ultimaActualizacion = 0;
+	sim->tramas = 0;
+	sim->bits = bits;
+	sim->actualizaciones = 0;
+	sim->registro = 0;
+	sim->bitsRecibidos = 0;
+	sim->ultimoCodigo = 0;
+	sim->ultimoRapido = false;
+	sim->ultimoApagado = false;
+	sim->traza = traza;
+	sim->vref = vref;
+
+	if (traza) {
+		fprintf(traza, "t_ns,codigo,rapido,apagado,vout,t_establecido_ns\n");
+	}
+}
+
+/*
+ * Convierte ciclos del sistema a ns
+ */
+double SSI0Sim_Ns(const t_SSI0Sim *sim, uint64_t ciclo) {
+	return (double)ciclo * 1e9 / sim->relojSistema;
+}
+
+/*
+ * Ciclo en que el SSI queda sin tramas pendientes (BSY = 0)
+ */
+uint64_t SSI0Sim_Idle(const t_SSI0Sim *sim) {
+	return sim->finUltima;
+}
+
+/*
+ * Escribe un dato en SSI0_DR en el ciclo dado, como SSI0_Out: si la FIFO esta llena espera
+ * a que la trama mas antigua pase al registro de desplazamiento.
+ * Devuelve el ciclo en que se acepto el dato.
+ */
+uint64_t SSI0Sim_Put(t_SSI0Sim *sim, uint64_t ciclo, uint16_t dato) {
+	uint64_t aceptado, inicio, bajada, establecido;
+	uint32_t slot = sim->tramas % SSI_FIFO_PALABRAS;
+	uint32_t b;
+	uint16_t codigo;
+	double vout;
+
+	// Con 8 tramas en la FIFO el espacio se libera cuando empieza la trama de hace 8 escrituras
+	aceptado = ciclo;
+	if (sim->tramas >= SSI_FIFO_PALABRAS && sim->inicio[slot] > aceptado) {
+		aceptado = sim->inicio[slot];
+	}
+	sim->ciclosEspera += aceptado - ciclo;
+
+	// Si la linea estaba libre, FSS va en alto un bit antes del MSB;
+	// en transmision continua el pulso de FSS coincide con el LSB de la trama anterior
+	if (aceptado >= sim->finUltima) {
+		inicio = aceptado + sim->cicloBit;
+	} else {
+		inicio = sim->finUltima;
+	}
+	sim->inicio[slot] = inicio;
+	sim->finUltima = inicio + sim->bits * sim->cicloBit;
+	sim->tramas++;
+
+	// El pulso de FS reinicia el registro del TLV5616
+	sim->bitsRecibidos = 0;
+	for (b = 0; b < sim->bits; b++) {
+		// El SSI cambia DIN en la subida (MSB primero), el TLV5616 lo lee en la bajada
+		bajada = inicio + b * sim->cicloBit + sim->cicloBit / 2;
+		if (sim->bitsRecibidos == 16) {
+			continue;		// ignora los bits de mas hasta el siguiente FS
+		}
+		sim->registro = (uint16_t)((sim->registro << 1) | ((dato >> (sim->bits - 1 - b)) & 0x1));
+		sim->bitsRecibidos++;
+		if (sim->bitsRecibidos < 16) {
+			continue;
+		}
+
+		// Bit 16: actualiza la salida con la trama desplazada
+		sim->ultimoRapido = (sim->registro & DAC_SPD_FAST) != 0;
+		sim->ultimoApagado = (sim->registro & DAC_PWR_DOWN) != 0;
+		codigo = sim->registro & DAC_CODIGO_M;
+		sim->ultimoCodigo = codigo;
+		vout = sim->ultimoApagado ? 0.0 : 2.0 * sim->vref * codigo / 4096.0;
+		establecido = (sim->ultimoRapido ? TLV5616_TS_FAST_NS : TLV5616_TS_SLOW_NS);
+
+		if (sim->actualizaciones == 0) {
+			sim->primeraActualizacion = bajada;
+		}
+		sim->ultimaActualizacion = bajada;
+		sim->actualizaciones++;
+
+		if (sim->traza) {
+			fprintf(sim->traza, "%.1f,%u,%d,%d,%.4f,%.1f\n", SSI0Sim_Ns(sim, bajada), codigo,
+					sim->ultimoRapido, sim->ultimoApagado, vout, SSI0Sim_Ns(sim, bajada) + establecido);
+		}
+	}
+	return aceptado;
+}
@@ -0,0 +1,58 @@
+/*
+ * ssi0_tlv5616.h
+ *
+ * Modelo para la PC del modulo SSI0 (formato TI, FIFO de 8 palabras) conectado al DAC TLV5616.
+ * El tiempo se lleva en ciclos del reloj del sistema. El SSI desplaza cada trama de `bits` bits
+ * (DSS) con el MSB primero, un bit por flanco de subida de SCLK, despues del pulso de FS. El
+ * TLV5616 reinicia su registro con cada FS, lee DIN en los flancos de bajada y con el bit 16
+ * actualiza la salida; la trama se decodifica (velocidad, potencia y codigo de 12 bits) desde los
+ * bits desplazados, asi un error de formato o de largo de palabra da otro codigo o ninguna
+ * actualizacion. Cada actualizacion se escribe como una linea en el archivo de traza:
+ *
+ * 	t_ns,codigo,rapido,apagado,vout,t_establecido_ns
+ */
+
+#ifndef SSI0_TLV5616_H_
+#define SSI0_TLV5616_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../tm4c_confSSI_test/ssi_clock.h"
+
+#define SSI_FIFO_PALABRAS	8
+
+// Tiempo de establecimiento de la salida del TLV5616 (hoja de datos, valores tipicos)
+#define TLV5616_TS_FAST_NS	3000
+#define TLV5616_TS_SLOW_NS	9000
+
+// Estadisticas del modelo
+struct estadoSSI0Sim {
+	uint32_t relojSistema;
+	uint32_t cicloBit;				// ciclos del sistema por bit de SSIClk
+	uint64_t inicio[SSI_FIFO_PALABRAS];	// inicio de las ultimas 8 tramas, para saber cuando hay espacio
+	uint64_t finUltima;				// ciclo en que termina la ultima trama
+	uint64_t ciclosEspera;			// ciclos que el CPU espero por espacio en la FIFO
+	uint64_t primeraActualizacion;	// actualizacion de la salida de la primera y la ultima trama
+	uint64_t ultimaActualizacion;
+	uint32_t tramas;
+	uint32_t bits;					// largo de la trama del SSI (DSS + 1)
+	uint32_t actualizaciones;		// tramas de 16 bits que recibio el TLV5616
+	uint16_t registro;				// registro de desplazamiento del TLV5616
+	uint32_t bitsRecibidos;			// bits desde el ultimo FS
+	uint16_t ultimoCodigo;			// decodificado de la ultima actualizacion
+	bool ultimoRapido;
+	bool ultimoApagado;
+	FILE *traza;
+	double vref;
+};
+
+typedef struct estadoSSI0Sim t_SSI0Sim;
+
+void SSI0Sim_Init(t_SSI0Sim *sim, uint32_t relojSistema, const t_planSSI *plan, uint32_t bits, double vref, FILE *traza);
+uint64_t SSI0Sim_Put(t_SSI0Sim *sim, uint64_t ciclo, uint16_t dato);
+uint64_t SSI0Sim_Idle(const t_SSI0Sim *sim);
+double SSI0Sim_Ns(const t_SSI0Sim *sim, uint64_t ciclo);
+
+#endif /* SSI0_TLV5616_H_ */
@@ -0,0 +1,50 @@
+/*
+ * tlv5616_tiempos.c
+ *
+ * Programa para la PC que verifica el planificador de reloj de SSI0 (tm4c_confSSI_test/ssi_clock.c)
+ * contra el modelo de tiempos de la trama TI del TLV5616 para los relojes del sistema usuales.
+ * Imprime el CPSDVSR/SCR elegido y los margenes de setup/hold, y termina con error si alguno es negativo
+ * o si existe un divisor mas rapido que tambien cumple.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../tm4c_confSSI_test/ssi_clock.h"
+
+// Relojes que se pueden obtener con SysCtlClockSet y el cristal de 16MHz
+static const uint32_t relojes[] = {16000000, 20000000, 25000000, 40000000, 50000000, 66666666, 80000000};
+
+int main(void) {
+	t_planSSI plan;
+	t_tiemposTLV5616 t;
+	uint32_t i, divisor, errores = 0;
+
+	printf("f_sistema  CPSDVSR  SCR  f_SSI     periodo  wh     wl     su_D   h_D    su_FS  c16FS  w_FS  [ns]\n");
+	for (i = 0; i < sizeof(relojes) / sizeof(relojes[0]); i++) {
+		if (!SSI_PlanReloj(relojes[i], &plan)) {
+			printf("%9lu  sin solucion\n", (unsigned long)relojes[i]);
+			errores++;
+			continue;
+		}
+		if (!TLV5616_Tiempos(relojes[i], plan.cpsdvsr, plan.scr, &t)) {
+			errores++;
+		}
+		printf("%9lu  %7u  %3u  %8lu  %7.1f  %5.1f  %5.1f  %5.1f  %5.1f  %5.1f  %5.1f  %5.1f\n",
+				(unsigned long)relojes[i], plan.cpsdvsr, plan.scr, (unsigned long)plan.bitRate,
+				t.periodo / 1000.0, t.wh / 1000.0, t.wl / 1000.0, t.setupDatos / 1000.0, t.holdDatos / 1000.0,
+				t.setupFS / 1000.0, t.c16FS / 1000.0, t.anchoFS / 1000.0);
+
+		// Ningun divisor par menor debe cumplir, si no el plan no es el mas rapido
+		for (divisor = 2; divisor < (uint32_t)plan.cpsdvsr * (1 + plan.scr); divisor += 2) {
+			if (TLV5616_Tiempos(relojes[i], 2, divisor / 2 - 1, &t)) {
+				printf("  ERROR: el divisor %lu tambien cumple\n", (unsigned long)divisor);
+				errores++;
+			}
+		}
+	}
+
+	printf("%s\n", errores ? "FALLA" : "OK");
+	return errores ? 1 : 0;
+}
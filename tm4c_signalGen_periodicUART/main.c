@@ -7,8 +7,14 @@
  * Programa de envio de seales periodicas por medio de valores de 8 bits a traves de la interfaz UART con la PC.
  * Las muestras se envian de forma periodica, y es posible cambiar la forma de onda presionando un boton en la Tiva Launchpad.
  *
+ * Con __VECTORES_RAM__ la tabla de vectores pasa a SRAM (IntRegister): vectores.c mide el despacho
+ * con la tabla de flash y la de SRAM en latenciaVectores y el tick de Timer0 se cambia en ejecucion
+ * por Int_Timer0A_Rapido, que borra la bandera con registros en lugar de TimerIntClear.
  */
 
+// Descomentar para usar la tabla de vectores en SRAM y el manejador rapido del tick
+//#define __VECTORES_RAM__
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "inc/hw_memmap.h"
@@ -23,22 +29,50 @@
 #include "driverlib/timer.h"
 #include "driverlib/uart.h"
 
+#include "antirrebote.h"
+#include "pin_gpio.h"
+#include "rueda.h"
+#include "reposo.h"
+// Reloj fijo de SysCtlClockSet (PLL / SYSCTL_SYSDIV_5 = 40MHz, divisor 10 de reloj.h)
+#define RELOJ_OBJETIVO	40000000
+#include "reloj.h"
+#include "divisor.h"
+#include "vectores.h"
+
 // Definiciones utiles
-#define LEDS	HWREG(GPIO_PORTF_BASE + 0x08 + 0x10 + 0x20)
+DEFINIR_PIN(LEDS, GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3)
 #define ESTADOS	4
 #define ROJO	0x02
 #define AZUL	0x04
 #define VERDE	0x08
 #define VIOLETA	0x06
+#define TICK_TIMER		(RELOJ_SISTEMA / 1000)	// tick de la rueda de temporizadores: 1ms
+#define PERIODO_MUESTRAS	5	// ticks entre muestras enviadas
+#define PERIODO_BOTON		5	// ticks entre lecturas del boton (4 muestras = 20ms sin rebote)
+#define BAUD_UART		9600
+typedef char uart_divisorValido[UART_DIVISOR_VALIDO(RELOJ_SISTEMA, BAUD_UART)];
 
 // Prototipos de funciones
 void ConfigurarLedsBotones(void);
 void ConfigurarTimer(unsigned long load);
 void ConfigurarUART(void);
+void MuestrearBoton(void *arg);
+void EnviarMuestra(void *arg);
 
 // Variables globales
 unsigned short estadoActual = 0;	// para llevar cual es el estado actual
 unsigned short contMuestras = 0;	// para llevar la cuenta de la muestra que toca
+t_antirrebote botones;				// antirrebote de PF0, muestreado cada 5ms en el timer
+t_temporizador tempMuestras;		// envio periodico de muestras
+t_temporizador tempBoton;			// lectura periodica del boton
+t_estadisticasReposo reposo;		// residencia en sleep y ticks omitidos
+
+#ifdef __VECTORES_RAM__
+t_latenciaVectores latenciaVectores;	// ciclos de despacho con la tabla de flash y de SRAM
+void Int_Timer0A_Rapido(void);
+// Sonda en un vector que no se usa, con su nombre debil para que tambien quede en flash
+VECTORES_SONDA(Int_Comp2_Handler)
+#endif
 
 // Maquina de estado
 struct estado {
@@ -66,19 +100,40 @@ t_estado maquinaEstados [ESTADOS] = {
 int main(void) {
 	// Configurar el reloj a 40MHz
 	SysCtlClockSet(SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ | SYSCTL_USE_PLL | SYSCTL_SYSDIV_5);
+	Reloj_Leer();
 
 	// Configurar los leds y botones
 	ConfigurarLedsBotones();
-	// Configura el timer periodico para 5ms
-	ConfigurarTimer(200000);
+	// Temporizadores por software sobre el tick de 1ms del TIMER0
+	Rueda_Init();
+	Rueda_Iniciar(&tempBoton, PERIODO_BOTON, PERIODO_BOTON, MuestrearBoton, 0);
+	Rueda_Iniciar(&tempMuestras, PERIODO_MUESTRAS, PERIODO_MUESTRAS, EnviarMuestra, 0);
+	// Configura el timer periodico para 1ms
+	ConfigurarTimer(TICK_TIMER);
 	// Configurar UART0 (puerto virtual) como 8N1@9600
 	ConfigurarUART();
 
+	// Reposo sin tick: el TIMER0 solo interrumpe en los ticks con temporizadores que vencen
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOF);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_TIMER0);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_UART0);
+	SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_GPIOA);
+	Reposo_Init(TIMER0_BASE);
+	Reposo_SinTick(Rueda_Proximo, Rueda_Tick);
+
 	// Habilitar interrupciones globales
 	IntMasterEnable();
 
+#ifdef __VECTORES_RAM__
+	// Medir el despacho y cambiar el manejador del tick en la tabla de SRAM
+	Vectores_Medir(INT_COMP2, Int_Comp2_Handler, &latenciaVectores);
+	IntRegister(INT_TIMER0A, Int_Timer0A_Rapido);
+#endif
+
 	for (;;) {
-		// ciclo principal
+		// ciclo principal: dormir hasta la siguiente interrupcion
+		Reposo_Esperar();
+		Reposo_Estadisticas(&reposo);
 	}
 }
 
@@ -88,20 +143,18 @@ int main(void) {
 void ConfigurarLedsBotones(void) {
 	// Configurar LEDs de salida
 	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
-	GPIOPinTypeGPIOOutput(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
-	GPIOPinWrite(GPIO_PORTF_BASE, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3, 0x02);
+	GPIO_BUS_INIT(SYSCTL_PERIPH_GPIOF);
+	GPIOPinTypeGPIOOutput(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
+	GPIOPinWrite(GPIO_PUERTO_F, GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3, 0x02);
 
 	// Configurar el boton para cambio de seal
-	GPIO_PORTF_LOCK_R = GPIO_LOCK_KEY;	// Desbloquear PF0
-	GPIO_PORTF_CR_R = 0x0f;
-	GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, GPIO_PIN_0);	// Configuracion como entrada
-	GPIOPadConfigSet(GPIO_PORTF_BASE, GPIO_PIN_0, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU); // Configuracion Pull-up resistor
-
-	// Configurar las interrupciones en el boton al flanco de bajada
-	GPIOIntTypeSet(GPIO_PORTF_BASE, GPIO_PIN_0, GPIO_FALLING_EDGE);
-	GPIOIntEnable(GPIO_PORTF_BASE, GPIO_INT_PIN_0);
-	IntEnable(INT_GPIOF);
-	IntPrioritySet(INT_GPIOF, 2);	// la prioridad del gpio es mas alta porque la cantidad de muestras desigual puede causar un fault
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_LOCK) = GPIO_LOCK_KEY;	// Desbloquear PF0
+	GPIO_REG(GPIO_PUERTO_F, GPIO_O_CR) = 0x0f;
+	GPIOPinTypeGPIOInput(GPIO_PUERTO_F, GPIO_PIN_0);	// Configuracion como entrada
+	GPIOPadConfigSet(GPIO_PUERTO_F, GPIO_PIN_0, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU); // Configuracion Pull-up resistor
+
+	// El boton se lee en el timer periodico, asi el cambio de estado no interrumpe el envio de muestras
+	Antirrebote_Init(&botones, GPIO_PUERTO_F, GPIO_PIN_0);
 }
 
 /*
@@ -134,35 +187,47 @@ void ConfigurarUART(void) {
 	GPIOPinConfigure(GPIO_PA1_U0TX);
 	GPIOPinTypeUART(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
 	// Configurar la velocidad
-	UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 9600, UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+	Divisor_UART(UART0_BASE, UART_DIVISOR(RELOJ_SISTEMA, BAUD_UART), UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
 	// Configuracion de interrupciones...[pendiente]
 }
 
 /*
- * Rutina de interrupcion de puerto F cuando se presione el boton
+ * Rutina de interrupcion de TIMER0 periodico, tick de la rueda de temporizadores
  */
-void Int_GPIOF_Handler(void) {
+void Int_Timer0A_Handler(void) {
 	// Borrar la interrupcion
-	GPIOIntClear(GPIO_PORTF_BASE, GPIO_INT_PIN_0);
+	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+
+	Rueda_Tick();
+}
+
+#ifdef __VECTORES_RAM__
+/*
+ * Tick de Timer0 instalado en ejecucion: borra la bandera directo en TIMER0_ICR
+ */
+void Int_Timer0A_Rapido(void) {
+	TIMER0_ICR_R = TIMER_ICR_TATOCINT;
 
-	// Quitar el rebote esperando 0.5ms
-	SysCtlDelay(20000);
-	if (GPIOPinRead(GPIO_PORTF_BASE, GPIO_PIN_0) == 0) {
-		// Cambiar de estado
+	Rueda_Tick();
+}
+#endif
+
+/*
+ * Temporizador del boton: cambiar de estado cuando el boton filtrado se presiona
+ */
+void MuestrearBoton(void *arg) {
+	Antirrebote_Muestrear(&botones);
+	if (Antirrebote_Presionados(&botones) & GPIO_PIN_0) {
 		estadoActual = (estadoActual + 1) % ESTADOS;
-		LEDS = maquinaEstados[estadoActual].salidaLeds;
+		LEDS_Escribir(maquinaEstados[estadoActual].salidaLeds);
 		contMuestras = 0;
 	}
 }
 
 /*
- * Rutina de interrupcion de TIMER0 periodico
+ * Temporizador de muestras: enviar la siguiente muestra por el puerto serial
  */
-void Int_Timer0_Handler(void) {
-	// Borrar la interrupcion
-	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
-
-	// Enviar muestra por el puerto serial
+void EnviarMuestra(void *arg) {
 	UARTCharPutNonBlocking(UART0_BASE, maquinaEstados[estadoActual].muestras[contMuestras]);
 	contMuestras = (contMuestras + 1) % maquinaEstados[estadoActual].longitudMuestras;
 }